@@ -4,31 +4,17 @@
 #include "framework/framework.hpp"
 #include <type_traits>
 
-template <size_t margin = 128, typename T>
-bool isWithinView(const T & target, const sf::View & view) {
-    const sf::Vector2f targetPos = target.getPosition();
-    const sf::Vector2f viewCenter = view.getCenter();
-    const sf::Vector2f viewSize = view.getSize();
-    if (targetPos.x > viewCenter.x - viewSize.x / 2 - margin &&
-        targetPos.x < viewCenter.x + viewSize.x / 2 + margin &&
-        targetPos.y > viewCenter.y - viewSize.y / 2 - margin &&
-        targetPos.y < viewCenter.y + viewSize.y / 2 + margin) {
-        return true;
-    }
-    return false;
-}
-
 struct ForceMain {
     using value_type = int;
     template <typename CallerType> void run(CallerType & ct, GfxContext & gfx) {
-        gfx.targetRef->draw(ct.getSprite());
+        gfx.direct.push_back(ct.getSprite());
     }
 };
 
 struct ForceShadow {
     using value_type = int;
     template <typename CallerType> void run(CallerType & ct, GfxContext & gfx) {
-        gfx.targetRef->draw(ct.getShadow());
+        gfx.direct.push_back(ct.getShadow());
     }
 };
 
@@ -84,12 +70,10 @@ template <typename... Args> struct RenderPolicy : public Wrapper<Args>... {
     // RenderPolicy() : Wrapper<Args>{}... {} FIXME: Microsoft compiler
     // complains about this... is this even necessary, if implicitly default
     // constructible?
+    // Whether it's on screen is up to the caller, see ViewCuller
     template <typename CallerType>
-    void draw(const CallerType & ct, GfxContext & gfxContext,
-              const sf::View & view) {
-        if (isWithinView(ct, view)) {
-            call<CallerType, Args...>(ct, gfxContext);
-        }
+    void draw(const CallerType & ct, GfxContext & gfxContext) {
+        call<CallerType, Args...>(ct, gfxContext);
     }
     template <typename CallerType, typename T, typename... Ts>
     void call(const CallerType & ct, GfxContext & gfxContext) {
@@ -104,7 +88,7 @@ template <typename... Args> struct RenderPolicy : public Wrapper<Args>... {
 template <typename Base, typename DrawPolicy>
 class Drawable : private DrawPolicy {
 public:
-    void draw(GfxContext & gfxContext, const sf::View & view) {
-        DrawPolicy::draw(*static_cast<Base *>(this), gfxContext, view);
+    void draw(GfxContext & gfxContext) {
+        DrawPolicy::draw(*static_cast<Base *>(this), gfxContext);
     }
 };
@@ -2,22 +2,26 @@
 #include "ResourcePath.hpp"
 #include "easingTemplates.hpp"
 #include "enemyPlacementFn.hpp"
-#include "initMapVectors.hpp"
-#include "lightingMap.hpp"
-#include "mappingFunctions.hpp"
 #include "math.h"
-#include "pillarPlacement.h"
+#include "rng.hpp"
 
-Game::Game(nlohmann::json & config)
-    : hasFocus(true), viewPort(getDrawableArea(config)),
-      transitionState(TransitionState::TransitionIn),
+// Without a screen to size things against, pretend to have a 1080p one
+static const sf::VideoMode headlessScreen(1920, 1080);
+
+Game::Game(nlohmann::json & config, Mode _mode)
+    : Game(config, _mode,
+           _mode == Mode::windowed ? sf::VideoMode::getDesktopMode()
+                                   : headlessScreen) {}
+
+Game::Game(nlohmann::json & config, Mode _mode, const sf::VideoMode & screen)
+    : viewPort(getDrawableArea(config, screen)),
+      transitionState(TransitionState::TransitionIn), mode(_mode),
+      hasFocus(true), input(config), sounds(_mode == Mode::windowed),
       player(viewPort.x / 2, viewPort.y / 2),
-      window(sf::VideoMode::getDesktopMode(), EXECUTABLE_NAME,
-             sf::Style::Fullscreen, sf::ContextSettings(0, 0, 6)),
-      input(config), camera(&player, viewPort, window.getSize()),
-      uiFrontend(
-          sf::View(sf::FloatRect(0, 0, window.getSize().x, window.getSize().y)),
-          viewPort.x / 2, viewPort.y / 2),
+      camera(&player, viewPort, sf::Vector2u(screen.width, screen.height)),
+      timestep(config), jobs(config), pacer(config),
+      uiFrontend(sf::View(sf::FloatRect(0, 0, screen.width, screen.height)),
+                 viewPort.x / 2, viewPort.y / 2),
       level(0), stashed(false), preload(false),
       worldView(sf::Vector2f(viewPort.x / 2, viewPort.y / 2), viewPort),
       timer(0) {
@@ -28,23 +32,53 @@ Game::Game(nlohmann::json & config)
         (viewPort.y * (visibleArea + 0.02)) / 450);
     vignetteSprite.setScale(vignetteMaskScale);
     vignetteShadowSpr.setScale(vignetteMaskScale);
-    windowView.setSize(window.getSize().x, window.getSize().y);
+    windowView.setSize(screen.width, screen.height);
     windowView.zoom(visibleArea);
     camera.setWindowView(windowView);
-    gfxContext.targetRef = &target;
-    window.requestFocus();
+    if (mode == Mode::windowed) {
+        window.reset(new sf::RenderWindow(screen, EXECUTABLE_NAME,
+                                          sf::Style::Fullscreen,
+                                          sf::ContextSettings(0, 0, 6)));
+        window->requestFocus();
+    }
     init();
+    // Give the render thread something to draw before the first tick
+    if (mode == Mode::windowed) {
+        captureSnapshot();
+    }
+}
+
+Game::~Game() { writeTelemetry(); }
+
+void Game::writeTelemetry() {
+    nlohmann::json extra;
+    extra["Mode"] = mode == Mode::windowed ? "windowed" : "headless";
+    extra["Level"] = level;
+    extra["Blur"] = UI.blurEnabled();
+    static const char * pacing[] = {"vsync", "sleep-spin", "uncapped"};
+    extra["FramePacing"] = pacing[static_cast<int>(pacer.getMode())];
+    extra["PathCache"] = {{"Hits", pathCache.getHits()},
+                          {"Misses", pathCache.getMisses()}};
+    telemetry.write(resourcePath() + "telemetry.json", extra);
 }
 
 void Game::init() {
-    target.create(viewPort.x, viewPort.y);
-    secondPass.create(viewPort.x, viewPort.y);
-    secondPass.setSmooth(true);
-    thirdPass.create(viewPort.x, viewPort.y);
-    thirdPass.setSmooth(true);
-    stash.create(viewPort.x, viewPort.y);
-    stash.setSmooth(true);
-    lightingMap.create(viewPort.x, viewPort.y);
+    if (mode == Mode::windowed) {
+        for (auto * texture : {&target, &secondPass, &thirdPass, &stash,
+                               &lightingMap}) {
+            texture->reset(new sf::RenderTexture);
+            (*texture)->create(viewPort.x, viewPort.y);
+        }
+        secondPass->setSmooth(true);
+        thirdPass->setSmooth(true);
+        stash->setSmooth(true);
+        tiles.setWindowSize(viewPort.x, viewPort.y);
+        // The pacer takes care of the frame rate, SFML's own limiter would
+        // fight it (and vsync)
+        window->setVerticalSyncEnabled(pacer.getMode() ==
+                                       FramePacer::Mode::vsync);
+        window->setMouseCursorVisible(false);
+    }
     vignetteSprite.setTexture(
         getgResHandlerPtr()->getTexture(ResHandler::Texture::vignette));
     vignetteShadowSpr.setTexture(
@@ -56,25 +90,21 @@ void Game::init() {
     hudView.setCenter(viewPort.x / 2, viewPort.y / 2);
     bkg.giveWindowSize(viewPort.x, viewPort.y);
     tiles.setPosition((viewPort.x / 2) - 16, (viewPort.y / 2));
-    tiles.setWindowSize(viewPort.x, viewPort.y);
     en.setWindowSize(viewPort.x, viewPort.y);
     beamGlowSpr.setColor(sf::Color(0, 0, 0, 255));
     transitionShape.setSize(sf::Vector2f(viewPort.x, viewPort.y));
     transitionShape.setFillColor(sf::Color(0, 0, 0, 0));
     vignetteSprite.setColor(sf::Color::White);
-    window.setVerticalSyncEnabled(true);
-    window.setFramerateLimit(120);
-    window.setMouseCursorVisible(false);
     level = -1;
     this->nextLevel();
 }
 
 void Game::eventLoop() {
     sf::Event event;
-    while (window.pollEvent(event)) {
+    while (window->pollEvent(event)) {
         switch (event.type) {
         case sf::Event::Closed:
-            window.close();
+            window->close();
             throw ShutdownSignal();
             break;
 
@@ -88,6 +118,16 @@ void Game::eventLoop() {
             sounds.pause(SoundController::Sound | SoundController::Music);
             break;
 
+#ifdef BLINDJUMP_PROFILE
+        case sf::Event::KeyPressed:
+            // Writes out what the profiler has recorded so far
+            if (event.key.code == sf::Keyboard::F9) {
+                PROFILE_DUMP(resourcePath() + "trace.json");
+            }
+            input.recordEvent(event);
+            break;
+#endif
+
         default:
             input.recordEvent(event);
             break;
@@ -103,17 +143,14 @@ void Game::drawTransitions(sf::RenderWindow & window) {
 
     case TransitionState::ExitBeamEnter:
         window.draw(beamShape);
-        gfxContext.glowSprs1.push_back(beamGlowSpr);
         break;
 
     case TransitionState::ExitBeamInflate:
         window.draw(beamShape);
-        gfxContext.glowSprs1.push_back(beamGlowSpr);
         break;
 
     case TransitionState::ExitBeamDeflate:
         window.draw(beamShape);
-        gfxContext.glowSprs1.push_back(beamGlowSpr);
         break;
 
     // This isn't stateless, but only because it can't be. Reseting the level
@@ -165,12 +202,10 @@ void Game::drawTransitions(sf::RenderWindow & window) {
 
     case TransitionState::EntryBeamDrop:
         window.draw(beamShape);
-        gfxContext.glowSprs1.push_back(beamGlowSpr);
         break;
 
     case TransitionState::EntryBeamFade:
         window.draw(beamShape);
-        gfxContext.glowSprs1.push_back(beamGlowSpr);
         break;
     }
 }
@@ -192,6 +227,7 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
                  UI.getPowerupBubbleState() ==
                      ui::Backend::PowerupBubbleState::dormant)) {
                 transitionState = TransitionState::ExitBeamEnter;
+                prepareNextLevel();
             }
         }
         beamShape.setPosition(viewPort.x / 2 - 1.5, viewPort.y / 2 + 48);
@@ -265,6 +301,14 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
     case TransitionState::TransitionOut:
         timer += elapsedTime.asMicroseconds();
         // Logic updates instead when drawing transitions, see above comment.
+        // Without a window there's no drawing, but also no textures to create,
+        // so the level can be reset here.
+        if (mode == Mode::headless &&
+            timer > (level != 0 ? 1000000 : 3000000)) {
+            transitionState = TransitionState::TransitionIn;
+            timer = 0;
+            this->nextLevel();
+        }
         break;
 
     case TransitionState::TransitionIn:
@@ -300,7 +344,7 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
                 transitionState = TransitionState::EntryBeamFade;
                 timer = 0;
                 player.visible = true;
-                util::sleep(milliseconds(20));
+                timeScale.hitStop(sf::milliseconds(20));
                 camera.shake(0.19f);
             }
         }
@@ -326,10 +370,29 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
     }
 }
 
+void Game::prepareNextLevel() {
+    if (nextBlueprint.valid()) {
+        return;
+    }
+    // The worker gets its own generator, seeded from this thread's so that
+    // a seeded run still generates the same levels
+    const unsigned seed = rng::RNG();
+    const bool withImages = mode == Mode::windowed;
+    nextBlueprint = std::async(std::launch::async, [seed, withImages]() {
+        PROFILE_THREAD("level builder");
+        rng::seed(seed);
+        return buildLevel(withImages);
+    });
+}
+
 void Game::nextLevel() {
+    PROFILE_ZONE(zone, "nextLevel");
     ++level;
     uiFrontend.setWaypointText(level);
     tiles.clear();
+    playerField.reset();
+    pathCache.clear();
+    pathQueue.clear();
     effectGroup.clear();
     detailGroup.clear();
     player.setPosition(viewPort.x / 2 - 17, viewPort.y / 2);
@@ -341,13 +404,19 @@ void Game::nextLevel() {
         camera.panDown();
         set = tileController::Tileset::regular;
     }
+    std::unique_ptr<LevelBlueprint> blueprint;
     if (set != tileController::Tileset::intro) {
-        int count;
-        do {
-            count = generateMap(tiles.mapArray);
-        } while (count < 150);
+        // Normally the worker started at ExitBeamEnter has finished by now,
+        // if it hasn't, waiting on it is still no worse than starting over
+        if (nextBlueprint.valid()) {
+            blueprint = nextBlueprint.get();
+        } else {
+            blueprint = buildLevel(mode == Mode::windowed);
+        }
+        tiles.rebuild(std::move(*blueprint));
+    } else {
+        tiles.rebuild(set);
     }
-    tiles.rebuild(set);
     bkg.setBkg(static_cast<uint8_t>(set));
     tiles.setPosition((viewPort.x / 2) - 16, (viewPort.y / 2));
     helperGroup.apply([this](auto & vec) {
@@ -408,36 +477,21 @@ void Game::nextLevel() {
         }
         gfxContext.glowSprs1.clear();
         gfxContext.glowSprs2.clear();
-        Circle teleporterFootprint;
-        teleporterFootprint.x = tiles.getTeleporterLoc().x;
-        teleporterFootprint.y = tiles.getTeleporterLoc().y;
-        teleporterFootprint.r = 50;
-        std::vector<Coordinate> detailPositions;
-        if (set == tileController::Tileset::regular) {
-            getRockPositions(tiles.mapArray, detailPositions,
-                             teleporterFootprint);
-            for (auto element : detailPositions) {
-                detailGroup.add<DetailRef::Rock>(
-                    tiles.posX + 32 * element.x,
-                    tiles.posY + 26 * element.y - 35,
-                    getgResHandlerPtr()->getTexture(
-                        ResHandler::Texture::gameObjects));
-            }
-            detailPositions.clear();
+        for (auto element : blueprint->rockPositions) {
+            detailGroup.add<DetailRef::Rock>(
+                tiles.posX + 32 * element.x, tiles.posY + 26 * element.y - 35,
+                getgResHandlerPtr()->getTexture(
+                    ResHandler::Texture::gameObjects));
         }
-        getLightingPositions(tiles.mapArray, detailPositions,
-                             teleporterFootprint);
-        const size_t len = detailPositions.size();
-        for (size_t i = 0; i < len; i++) {
+        for (auto element : blueprint->lampPositions) {
             detailGroup.add<DetailRef::Lamp>(
-                tiles.posX + 16 + (detailPositions[i].x * 32),
-                tiles.posY - 3 + (detailPositions[i].y * 26),
+                tiles.posX + 16 + (element.x * 32),
+                tiles.posY - 3 + (element.y * 26),
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::lamplight));
         }
-        detailPositions.clear();
     } else if (set == tileController::Tileset::intro) {
         detailGroup.add<DetailRef::Lamp>(
             tiles.posX - 180 + 16 + (5 * 32), tiles.posY + 200 - 3 + (6 * 26),
@@ -478,6 +532,7 @@ void Game::nextLevel() {
             wall w;
             w.setXinit(it->first);
             w.setYinit(it->second);
+            w.setPosition(it->first, it->second);
             tiles.walls.push_back(w);
         }
     }
@@ -487,6 +542,16 @@ DetailGroup & Game::getDetails() { return detailGroup; }
 
 HelperGroup & Game::getHelperGroup() { return helperGroup; }
 
+CollisionIndex & Game::getCollisionIndex() { return collisions; }
+
+ViewCuller & Game::getViewCuller() { return culler; }
+
+FlowField & Game::getPlayerField() { return playerField; }
+
+PathCache & Game::getPathCache() { return pathCache; }
+
+PathQueue & Game::getPathQueue() { return pathQueue; }
+
 enemyController & Game::getEnemyController() { return en; }
 
 tileController & Game::getTileController() { return tiles; }
@@ -495,6 +560,12 @@ Player & Game::getPlayer() { return player; }
 
 Camera & Game::getCamera() { return camera; }
 
+FixedTimestep & Game::getTimestep() { return timestep; }
+
+JobSystem & Game::getJobSystem() { return jobs; }
+
+TimeScale & Game::getTimeScale() { return timeScale; }
+
 EffectGroup & Game::getEffects() { return effectGroup; }
 
 InputController & Game::getInputController() { return input; }
@@ -507,7 +578,7 @@ SoundController & Game::getSounds() { return sounds; }
 
 int Game::getLevel() { return level; }
 
-sf::RenderWindow & Game::getWindow() { return window; }
+sf::RenderWindow & Game::getWindow() { return *window; }
 
 const std::array<std::pair<float, float>, 59> levelZeroWalls{
     {{-20, 500}, {-20, 526}, {-20, 474}, {-20, 448}, {-20, 422}, {-20, 396},
@@ -4,24 +4,37 @@
 #include "GfxContext.hpp"
 #include "HelperGroup.hpp"
 #include "RenderType.hpp"
+#include "aStar.hpp"
 #include "alias.hpp"
 #include "aspectScaling.hpp"
 #include "backgroundHandler.hpp"
 #include "camera.hpp"
+#include "collisionIndex.hpp"
 #include "colors.hpp"
 #include "effectsController.hpp"
 #include "enemyController.hpp"
+#include "fixedTimestep.hpp"
+#include "framePacer.hpp"
 #include "framework/option.hpp"
+#include "framework/profiler.hpp"
+#include "framework/tripleBuffer.hpp"
 #include "inputController.hpp"
+#include "jobSystem.hpp"
 #include "player.hpp"
+#include "renderSnapshot.hpp"
 #include "resourceHandler.hpp"
 #include "soundController.hpp"
+#include "telemetry.hpp"
+#include "timeScale.hpp"
 #include "tileController.hpp"
 #include "userInterface.hpp"
+#include "viewCuller.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <atomic>
 #include <cmath>
+#include <future>
+#include <memory>
 #include <mutex>
 
 class Game {
@@ -36,7 +49,12 @@ public:
         EntryBeamDrop,
         EntryBeamFade
     };
-    Game(nlohmann::json & json);
+    // A headless game never opens a window or draws anything, it only runs
+    // the logic, see headless.hpp
+    enum class Mode { windowed, headless };
+    Game(nlohmann::json & json, Mode mode = Mode::windowed);
+    // Writes out the telemetry report
+    ~Game();
     void updateLogic(const sf::Time &);
     void updateGraphics();
     void eventLoop();
@@ -52,25 +70,49 @@ public:
     ui::Backend & getUI();
     ui::Frontend & getUIFrontend();
     Camera & getCamera();
+    FixedTimestep & getTimestep();
+    JobSystem & getJobSystem();
+    TimeScale & getTimeScale();
     sf::Vector2f viewPort;
     TransitionState transitionState;
+    // A headless game has no window, see Mode
     sf::RenderWindow & getWindow();
     HelperGroup & getHelperGroup();
+    CollisionIndex & getCollisionIndex();
+    ViewCuller & getViewCuller();
+    // Leads to the player's tile, or the last walkable one it stood on
+    FlowField & getPlayerField();
+    // For the paths that don't lead to the player
+    PathCache & getPathCache();
+    PathQueue & getPathQueue();
 
 private:
+    Game(nlohmann::json &, Mode, const sf::VideoMode &);
     void init();
+    const Mode mode;
     bool hasFocus;
-    sf::RenderWindow window;
+    // Only made for Mode::windowed, like the render textures below. Even an
+    // idle one sets up a GL context, which a headless game has no use for.
+    std::unique_ptr<sf::RenderWindow> window;
     InputController input;
     SoundController sounds;
     Player player;
     Camera camera;
+    FixedTimestep timestep;
+    JobSystem jobs;
+    FramePacer pacer;
+    TimeScale timeScale;
     ui::Backend UI;
     tileController tiles;
     EffectGroup effectGroup;
     DetailGroup detailGroup;
     HelperGroup helperGroup;
     enemyController en;
+    CollisionIndex collisions;
+    ViewCuller culler;
+    FlowField playerField;
+    PathCache pathCache;
+    PathQueue pathQueue;
     ui::Frontend uiFrontend;
     std::mutex overworldMutex, UIMutex, transitionMutex;
     int level;
@@ -79,13 +121,24 @@ private:
     backgroundHandler bkg;
     sf::Sprite vignetteShadowSpr;
     tileController::Tileset set;
+    // Render thread scratch space, the overworld arrives through snapshots
     GfxContext gfxContext;
+    TripleBuffer<RenderSnapshot> snapshots;
+    Telemetry telemetry;
+    // When the last frame was displayed, render thread only
+    time_point lastFrame;
+    void writeTelemetry();
     sf::Sprite beamGlowSpr;
     sf::View worldView, hudView;
-    sf::RenderTexture lightingMap;
-    sf::RenderTexture target, secondPass, thirdPass, stash;
+    std::unique_ptr<sf::RenderTexture> lightingMap;
+    std::unique_ptr<sf::RenderTexture> target, secondPass, thirdPass, stash;
     sf::RectangleShape transitionShape, beamShape;
+    // The next level is built on a worker thread while the teleporter
+    // transition plays, nextLevel() picks it up
+    std::future<std::unique_ptr<LevelBlueprint>> nextBlueprint;
+    void prepareNextLevel();
     void updateTransitions(const sf::Time &);
+    void captureSnapshot();
     void drawTransitions(sf::RenderWindow &);
     int_fast64_t timer;
 };
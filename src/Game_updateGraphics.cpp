@@ -1,51 +1,62 @@
 #include "Game.hpp"
 
 void Game::updateGraphics() {
-    window.clear();
+    PROFILE_ZONE(frameZone, "frame");
+    window->clear();
     if (!hasFocus) {
-        util::sleep(milliseconds(200));
+        std::this_thread::sleep_for(milliseconds(200));
+        // Don't count the time spent out of focus as a frame
+        lastFrame = time_point();
         return;
     }
-    target.clear(sf::Color::Transparent);
+    target->clear(sf::Color::Transparent);
+    const RenderSnapshot & snapshot = snapshots.acquire();
+    // How far the logic thread has got past the tick that produced the
+    // snapshot, used to blend object and camera positions with the tick before
+    const float interpolation = timestep.getInterpolation(snapshot.tickTime);
     if (!stashed || preload) {
+        const sf::View cameraView = snapshot.getOverworldView(interpolation);
+        if (snapshot.level != 0) {
+            bkg.setOffset(snapshot.cameraOffsetFromStart.x,
+                          snapshot.cameraOffsetFromStart.y);
+        } else { // TODO: why is this necessary...?
+            bkg.setOffset(0, 0);
+        }
+        lightingMap->setView(cameraView);
+        bkg.drawBackground(*target, worldView, cameraView,
+                           snapshot.cameraOffsetFromTarget);
+        // The tiles are lit by this frame's glows, so the snapshot goes first
+        gfxContext = snapshot.gfx;
+        gfxContext.interpolate(interpolation);
         {
-            std::lock_guard<std::mutex> overworldLock(overworldMutex);
-            lightingMap.setView(camera.getOverworldView());
-            bkg.drawBackground(target, worldView, camera);
-            tiles.draw(target, &gfxContext.glowSprs1, level, worldView,
-                       camera.getOverworldView());
-            gfxContext.glowSprs2.clear();
-            gfxContext.glowSprs1.clear();
-            gfxContext.shadows.clear();
-            gfxContext.faces.clear();
-            target.setView(camera.getOverworldView());
-            auto drawPolicy = [this](auto & vec) {
-                for (auto it = vec.begin(); it != vec.end(); ++it) {
-                    it->get()->draw(gfxContext, camera.getOverworldView());
-                }
-            };
-            detailGroup.apply(drawPolicy);
-            if (player.visible) {
-                player.draw(gfxContext.faces, gfxContext.shadows);
-            }
-            effectGroup.apply(drawPolicy);
-            helperGroup.apply(drawPolicy);
-            en.draw(gfxContext.faces, gfxContext.shadows, camera);
-            sounds.update();
+            PROFILE_ZONE(zone, "tiles.draw");
+            tiles.draw(*target, &gfxContext.glowSprs1, snapshot.level,
+                       worldView, cameraView);
+        }
+        target->setView(cameraView);
+        for (const auto & element : gfxContext.direct) {
+            target->draw(element);
         }
         if (!gfxContext.shadows.empty()) {
             for (const auto & element : gfxContext.shadows) {
-                target.draw(std::get<0>(element));
+                target->draw(std::get<0>(element));
             }
         }
-        target.setView(worldView);
-        lightingMap.clear(sf::Color::Transparent);
+        target->setView(worldView);
+        lightingMap->clear(sf::Color::Transparent);
         static const size_t zOrderIdx = 1;
-        std::sort(
-            gfxContext.faces.begin(), gfxContext.faces.end(),
-            [](const drawableMetadata & arg1, const drawableMetadata & arg2) {
-                return (std::get<zOrderIdx>(arg1) < std::get<zOrderIdx>(arg2));
-            });
+        {
+            PROFILE_ZONE(zone, "sort faces");
+            PROFILE_ARG(zone, "faces", gfxContext.faces.size());
+            std::sort(gfxContext.faces.begin(), gfxContext.faces.end(),
+                      [](const drawableMetadata & arg1,
+                         const drawableMetadata & arg2) {
+                          return (std::get<zOrderIdx>(arg1) <
+                                  std::get<zOrderIdx>(arg2));
+                      });
+        }
+        PROFILE_ZONE(lightingZone, "lighting");
+        PROFILE_ARG(lightingZone, "glows", gfxContext.glowSprs2.size());
         static const size_t sprIdx = 0;
         static const size_t shaderIdx = 3;
         sf::Shader & colorShader =
@@ -55,11 +66,11 @@ void Game::updateGraphics() {
             case Rendertype::shadeDefault:
                 std::get<0>(element).setColor(sf::Color(
                     190, 190, 210, std::get<sprIdx>(element).getColor().a));
-                lightingMap.draw(std::get<sprIdx>(element));
+                lightingMap->draw(std::get<sprIdx>(element));
                 break;
 
             case Rendertype::shadeNone:
-                lightingMap.draw(std::get<sprIdx>(element));
+                lightingMap->draw(std::get<sprIdx>(element));
                 break;
 
 #define COLOR_LABEL(C, TYPE)                                                   \
@@ -68,7 +79,7 @@ void Game::updateGraphics() {
                                       colors::C::b);                           \
         colorShader.setUniform("amount", std::get<shaderIdx>(element));        \
         colorShader.setUniform("targetColor", C);                              \
-        lightingMap.draw(std::get<sprIdx>(element), &colorShader);             \
+        lightingMap->draw(std::get<sprIdx>(element), &colorShader);            \
     } break
 
                 COLOR_LABEL(White, shadeWhite);
@@ -82,102 +93,102 @@ void Game::updateGraphics() {
         sf::Sprite tempSprite;
         for (auto & element : gfxContext.glowSprs2) {
             element.setColor(blendAmount);
-            lightingMap.draw(element,
-                             sf::BlendMode(sf::BlendMode(
-                                 sf::BlendMode::SrcAlpha, sf::BlendMode::One,
-                                 sf::BlendMode::Add, sf::BlendMode::DstAlpha,
-                                 sf::BlendMode::Zero, sf::BlendMode::Add)));
+            lightingMap->draw(element,
+                              sf::BlendMode(sf::BlendMode(
+                                  sf::BlendMode::SrcAlpha, sf::BlendMode::One,
+                                  sf::BlendMode::Add, sf::BlendMode::DstAlpha,
+                                  sf::BlendMode::Zero, sf::BlendMode::Add)));
         }
-        lightingMap.display();
-        target.draw(sf::Sprite(lightingMap.getTexture()));
-        target.setView(camera.getOverworldView());
-        bkg.drawForeground(target);
-        target.setView(worldView);
+        lightingMap->display();
+        target->draw(sf::Sprite(lightingMap->getTexture()));
+        target->setView(cameraView);
+        bkg.drawForeground(*target);
+        target->setView(worldView);
         sf::Vector2f fgMaskPos(
-            viewPort.x * 0.115f + camera.getOffsetFromTarget().x * 0.75f,
-            viewPort.y * 0.115f + camera.getOffsetFromTarget().y * 0.75f);
+            viewPort.x * 0.115f + snapshot.cameraOffsetFromTarget.x * 0.75f,
+            viewPort.y * 0.115f + snapshot.cameraOffsetFromTarget.y * 0.75f);
         vignetteSprite.setPosition(fgMaskPos);
         vignetteShadowSpr.setPosition(fgMaskPos);
-        target.draw(vignetteSprite, sf::BlendMultiply);
-        target.draw(vignetteShadowSpr);
-        target.display();
+        target->draw(vignetteSprite, sf::BlendMultiply);
+        target->draw(vignetteShadowSpr);
+        target->display();
     }
-    const sf::Vector2u windowSize = window.getSize();
+    const sf::View windowView = snapshot.getWindowView(interpolation);
+    const sf::Vector2u windowSize = window->getSize();
     const sf::Vector2f upscaleVec(windowSize.x / viewPort.x,
                                   windowSize.y / viewPort.y);
     if (UI.blurEnabled() && UI.desaturateEnabled()) {
         if (stashed) {
-            sf::Sprite targetSprite(stash.getTexture());
-            window.setView(camera.getWindowView());
+            sf::Sprite targetSprite(stash->getTexture());
+            window->setView(windowView);
             targetSprite.setScale(upscaleVec);
-            window.draw(targetSprite);
+            window->draw(targetSprite);
         } else {
+            PROFILE_ZONE(zone, "blur");
             sf::Shader & blurShader =
                 getgResHandlerPtr()->getShader(ResHandler::Shader::blur);
             sf::Shader & desaturateShader =
                 getgResHandlerPtr()->getShader(ResHandler::Shader::desaturate);
-            secondPass.clear(sf::Color::Transparent);
-            thirdPass.clear(sf::Color::Transparent);
-            const sf::Vector2u textureSize = target.getSize();
+            secondPass->clear(sf::Color::Transparent);
+            thirdPass->clear(sf::Color::Transparent);
+            const sf::Vector2u textureSize = target->getSize();
             float blurAmount = UI.getBlurAmount();
             const sf::Glsl::Vec2 vBlur =
                 sf::Glsl::Vec2(0.f, blurAmount / textureSize.y);
             blurShader.setUniform("blur_radius", vBlur);
-            secondPass.draw(sf::Sprite(target.getTexture()), &blurShader);
-            secondPass.display();
+            secondPass->draw(sf::Sprite(target->getTexture()), &blurShader);
+            secondPass->display();
             const sf::Glsl::Vec2 hBlur =
                 sf::Glsl::Vec2(blurAmount / textureSize.x, 0.f);
             blurShader.setUniform("blur_radius", hBlur);
-            thirdPass.draw(sf::Sprite(secondPass.getTexture()), &blurShader);
-            thirdPass.display();
+            thirdPass->draw(sf::Sprite(secondPass->getTexture()), &blurShader);
+            thirdPass->display();
             desaturateShader.setUniform("amount", UI.getDesaturateAmount());
-            sf::Sprite targetSprite(thirdPass.getTexture());
-            window.setView(camera.getWindowView());
+            sf::Sprite targetSprite(thirdPass->getTexture());
+            window->setView(windowView);
             targetSprite.setScale(upscaleVec);
-            window.draw(targetSprite, &desaturateShader);
+            window->draw(targetSprite, &desaturateShader);
             if (!stashed && (UI.getState() == ui::Backend::State::statsScreen ||
                              UI.getState() == ui::Backend::State::menuScreen) &&
-                !camera.moving()) {
-                stash.clear(sf::Color::Black);
-                stash.draw(sf::Sprite(thirdPass.getTexture()),
-                           &desaturateShader);
-                stash.display();
+                !snapshot.cameraMoving) {
+                stash->clear(sf::Color::Black);
+                stash->draw(sf::Sprite(thirdPass->getTexture()),
+                            &desaturateShader);
+                stash->display();
                 stashed = true;
             }
         }
     } else if (UI.blurEnabled() && !UI.desaturateEnabled()) {
         if (stashed) {
-            if (input.pausePressed()) {
-                preload = true;
-            }
-            sf::Sprite targetSprite(stash.getTexture());
-            window.setView(camera.getWindowView());
+            sf::Sprite targetSprite(stash->getTexture());
+            window->setView(windowView);
             targetSprite.setScale(upscaleVec);
-            window.draw(targetSprite);
+            window->draw(targetSprite);
         } else {
+            PROFILE_ZONE(zone, "blur");
             sf::Shader & blurShader =
                 getgResHandlerPtr()->getShader(ResHandler::Shader::blur);
-            secondPass.clear(sf::Color::Transparent);
-            sf::Vector2u textureSize = target.getSize();
+            secondPass->clear(sf::Color::Transparent);
+            sf::Vector2u textureSize = target->getSize();
             float blurAmount = UI.getBlurAmount();
             const sf::Glsl::Vec2 vBlur =
                 sf::Glsl::Vec2(0.f, blurAmount / textureSize.y);
             blurShader.setUniform("blur_radius", vBlur);
-            secondPass.draw(sf::Sprite(target.getTexture()), &blurShader);
-            secondPass.display();
+            secondPass->draw(sf::Sprite(target->getTexture()), &blurShader);
+            secondPass->display();
             const sf::Glsl::Vec2 hBlur =
                 sf::Glsl::Vec2(blurAmount / textureSize.x, 0.f);
             blurShader.setUniform("blur_radius", hBlur);
-            sf::Sprite targetSprite(secondPass.getTexture());
-            window.setView(camera.getWindowView());
+            sf::Sprite targetSprite(secondPass->getTexture());
+            window->setView(windowView);
             targetSprite.setScale(upscaleVec);
-            window.draw(targetSprite, &blurShader);
+            window->draw(targetSprite, &blurShader);
             if (!stashed && (UI.getState() == ui::Backend::State::statsScreen ||
                              UI.getState() == ui::Backend::State::menuScreen) &&
-                !camera.moving()) {
-                stash.clear(sf::Color::Black);
-                stash.draw(sf::Sprite(secondPass.getTexture()), &blurShader);
-                stash.display();
+                !snapshot.cameraMoving) {
+                stash->clear(sf::Color::Black);
+                stash->draw(sf::Sprite(secondPass->getTexture()), &blurShader);
+                stash->display();
                 stashed = true;
                 preload = false;
             }
@@ -186,28 +197,38 @@ void Game::updateGraphics() {
         sf::Shader & desaturateShader =
             getgResHandlerPtr()->getShader(ResHandler::Shader::desaturate);
         desaturateShader.setUniform("amount", UI.getDesaturateAmount());
-        sf::Sprite targetSprite(target.getTexture());
-        window.setView(camera.getWindowView());
+        sf::Sprite targetSprite(target->getTexture());
+        window->setView(windowView);
         targetSprite.setScale(upscaleVec);
-        window.draw(targetSprite, &desaturateShader);
+        window->draw(targetSprite, &desaturateShader);
     } else {
-        sf::Sprite targetSprite(target.getTexture());
-        window.setView(camera.getWindowView());
+        sf::Sprite targetSprite(target->getTexture());
+        window->setView(windowView);
         targetSprite.setScale(upscaleVec);
-        window.draw(targetSprite);
+        window->draw(targetSprite);
     }
     {
         std::lock_guard<std::mutex> UILock(UIMutex);
         if (player.getState() == Player::State::dead) {
-            UI.draw(window, uiFrontend);
+            UI.draw(*window, uiFrontend);
         } else {
             if (transitionState == TransitionState::None) {
-                UI.draw(window, uiFrontend);
+                UI.draw(*window, uiFrontend);
             }
-            uiFrontend.draw(window);
+            uiFrontend.draw(*window);
         }
     }
-    window.setView(worldView);
-    drawTransitions(window);
-    window.display();
+    window->setView(worldView);
+    drawTransitions(*window);
+    high_resolution_clock::duration wakeError;
+    if (pacer.wait(wakeError)) {
+        telemetry.recordWakeError(wakeError);
+    }
+    PROFILE_ZONE(displayZone, "window->display");
+    window->display();
+    const time_point now = high_resolution_clock::now();
+    if (lastFrame != time_point()) {
+        telemetry.recordFrame(now - lastFrame);
+    }
+    lastFrame = now;
 }
@@ -1,8 +1,20 @@
 #include "Game.hpp"
 
+// How many tiles the path queue gets to search through each tick, a little
+// over half the map
+static const int pathBudget = 2048;
+
 void Game::updateLogic(const sf::Time & elapsedTime) {
+    PROFILE_ZONE(tickZone, "tick");
+    const time_point tickStart = high_resolution_clock::now();
+    if (Telemetry::takeReportRequest()) {
+        writeTelemetry();
+    }
+    input.update(timestep.getTickTime());
+    // The fixed timestep keeps calling at the tick rate, there's just nothing
+    // to do until the window gets focus back. Those ticks aren't worth
+    // recording either.
     if (!hasFocus) {
-	util::sleep(milliseconds(200));
 	return;
     }
     // Blurring is graphics intensive, the game caches frames in a RenderTexture
@@ -11,38 +23,101 @@ void Game::updateLogic(const sf::Time & elapsedTime) {
         UI.getState() != ui::Backend::State::menuScreen) {
         stashed = false;
     }
+    // Start drawing the overworld again before the pause menu closes, so that
+    // there's a fresh frame to fade back into
+    if (stashed && UI.blurEnabled() && !UI.desaturateEnabled() &&
+        input.pausePressed()) {
+        preload = true;
+    }
+    // A hit stop skips the player, whose taps then wait for the next tick
+    bool inputDeferred = false;
     if (!stashed || preload) {
         std::lock_guard<std::mutex> overworldLock(overworldMutex);
-        if (level != 0) {
-            const sf::Vector2f & cameraOffset = camera.getOffsetFromStart();
-            bkg.setOffset(cameraOffset.x, cameraOffset.y);
-        } else { // TODO: why is this necessary...?
-            bkg.setOffset(0, 0);
-        }
-        tiles.update();
-        auto objUpdatePolicy = [&elapsedTime, this](auto & vec) {
+        // Remember where everything was at the start of the tick, so that the
+        // renderer can interpolate between this tick and the next
+        auto savePolicy = [](auto & vec) {
+            for (auto & element : vec) {
+                element->savePosition();
+            }
+        };
+        detailGroup.apply(savePolicy);
+        helperGroup.apply(savePolicy);
+        effectGroup.apply(savePolicy);
+        en.savePositions();
+        player.savePosition();
+        camera.savePosition();
+        // Hit stop slows or freezes the entities, the camera runs on real time
+        // so that screen shake still plays out during a freeze
+        const sf::Time worldTime = timeScale.update(elapsedTime);
+        const bool worldFrozen = worldTime == sf::Time::Zero;
+        inputDeferred = worldFrozen && player.visible && !UI.isOpen();
+        auto objUpdatePolicy = [&worldTime, this](auto & vec) {
             for (auto it = vec.begin(); it != vec.end();) {
                 if ((*it)->getKillFlag()) {
                     it = vec.erase(it);
                 } else {
-                    (*it)->update(elapsedTime, this);
+                    (*it)->update(worldTime, this);
                     ++it;
                 }
             }
         };
-        detailGroup.apply(objUpdatePolicy);
-        helperGroup.apply(objUpdatePolicy);
+        // Laika picks targets and the enemies wake up by what's on screen,
+        // neither of which moves anything until en.update
+        culler.setView(camera.getOverworldView());
+        {
+            // Critters and Laika find their way to the player by reading
+            // this, it only needs searching again when the player steps onto
+            // another tile
+            PROFILE_ZONE(zone, "playerField.update");
+            playerField.update((tiles.posX - player.getXpos() - 12) / -32,
+                               (tiles.posY - player.getYpos() - 32) / -26,
+                               tiles.layers);
+        }
+        {
+            // Paths asked for on earlier ticks, found in time for whoever
+            // asked to pick them up in their update
+            PROFILE_ZONE(zone, "pathQueue.service");
+            pathQueue.service(tiles.layers, pathCache, pathBudget);
+        }
+        if (!worldFrozen) {
+            PROFILE_ZONE(zone, "details.update");
+            PROFILE_ARG(zone, "details", detailGroup.size());
+            PROFILE_ARG(zone, "helpers", helperGroup.size());
+            detailGroup.apply(objUpdatePolicy);
+            helperGroup.apply(objUpdatePolicy);
+        }
         std::vector<sf::Vector2f> cameraTargets;
-        en.update(this, !UI.isOpen(), elapsedTime, cameraTargets);
+        {
+            PROFILE_ZONE(zone, "collisions.fileForEnemies");
+            collisions.fileForEnemies(effectGroup, helperGroup);
+        }
+        {
+            PROFILE_ZONE(zone, "en.update");
+            PROFILE_ARG(zone, "turrets", en.getTurrets().size());
+            PROFILE_ARG(zone, "scoots", en.getScoots().size());
+            PROFILE_ARG(zone, "dashers", en.getDashers().size());
+            PROFILE_ARG(zone, "critters", en.getCritters().size());
+            en.update(this, !UI.isOpen() && !worldFrozen, worldTime,
+                      cameraTargets);
+        }
         camera.update(elapsedTime, cameraTargets);
-        if (player.visible) {
-            player.update(this, elapsedTime, sounds);
+        if (player.visible && !worldFrozen) {
+            PROFILE_ZONE(zone, "player.update");
+            // After the enemies have moved and dropped items
+            collisions.fileForPlayer(effectGroup, en);
+            player.update(this, worldTime, sounds);
             const sf::Vector2f playerPos = player.getPosition();
             sf::Listener::setPosition(playerPos.x, playerPos.y, 35.f);
         }
-        if (!UI.isOpen()) {
+        if (!UI.isOpen() && !worldFrozen) {
+            PROFILE_ZONE(zone, "effects.update");
+            PROFILE_ARG(zone, "effects", effectGroup.size());
             effectGroup.apply(objUpdatePolicy);
         }
+        sounds.update();
+        if (mode == Mode::windowed) {
+            captureSnapshot();
+        }
     }
     {
         std::lock_guard<std::mutex> UILock(UIMutex);
@@ -70,4 +145,61 @@ void Game::updateLogic(const sf::Time & elapsedTime) {
         }
     }
     updateTransitions(elapsedTime);
+    if (!inputDeferred) {
+        input.consumeEdges();
+    }
+    telemetry.recordTick(high_resolution_clock::now() - tickStart);
+}
+
+void Game::captureSnapshot() {
+    PROFILE_ZONE(zone, "captureSnapshot");
+    RenderSnapshot & snapshot = snapshots.back();
+    GfxContext & gfx = snapshot.gfx;
+    gfx.clear();
+    const sf::View & cameraView = camera.getOverworldView();
+    culler.setView(cameraView);
+    auto drawPolicy = [&gfx, this](auto & vec) {
+        culler.forEachVisible(vec, 128, [&gfx](const auto & element) {
+            const GfxContext::Mark mark = gfx.mark();
+            element->draw(gfx);
+            gfx.recordMotion(mark, element->getTickDelta());
+        });
+    };
+    detailGroup.apply(drawPolicy);
+    if (player.visible) {
+        const GfxContext::Mark mark = gfx.mark();
+        player.draw(gfx.faces, gfx.shadows);
+        gfx.recordMotion(mark, player.getTickDelta());
+    }
+    effectGroup.apply(drawPolicy);
+    helperGroup.apply(drawPolicy);
+    en.draw(gfx, culler);
+    {
+        // The teleporter beam lights up the tiles around it while it's out
+        std::lock_guard<std::mutex> transitionLock(transitionMutex);
+        switch (transitionState) {
+        case TransitionState::ExitBeamEnter:
+        case TransitionState::ExitBeamInflate:
+        case TransitionState::ExitBeamDeflate:
+        case TransitionState::EntryBeamDrop:
+        case TransitionState::EntryBeamFade:
+            gfx.glowSprs1.push_back(beamGlowSpr);
+            break;
+
+        default:
+            break;
+        }
+    }
+    snapshot.prevOverworldView = camera.getPrevOverworldView();
+    snapshot.overworldView = cameraView;
+    snapshot.prevWindowView = camera.getPrevWindowView();
+    snapshot.windowView = camera.getWindowView();
+    snapshot.cameraOffsetFromStart = camera.getOffsetFromStart();
+    snapshot.cameraOffsetFromTarget = camera.getOffsetFromTarget();
+    snapshot.cameraMoving = camera.moving();
+    snapshot.level = level;
+    snapshot.tickTime = timestep.getTickTime();
+    PROFILE_ARG(zone, "faces", gfx.faces.size());
+    PROFILE_ARG(zone, "shadows", gfx.shadows.size());
+    snapshots.publish();
 }
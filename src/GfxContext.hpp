@@ -8,7 +8,64 @@
 using drawContext = std::tuple<sf::Sprite, float, Rendertype, float>;
 
 struct GfxContext {
+    struct Mark {
+        size_t direct, faces, shadows, glowSprs1, glowSprs2;
+    };
+    // Everything emitted between two marks belongs to one object, which moved
+    // by -delta over the last logic tick
+    struct Motion {
+        Mark begin, end;
+        sf::Vector2f delta;
+    };
+    // Sprites drawn straight to the target, in order, before anything else
+    std::vector<sf::Sprite> direct;
     std::vector<drawContext> faces, shadows;
     std::vector<sf::Sprite> glowSprs1, glowSprs2;
-    sf::RenderTexture * targetRef;
+    std::vector<Motion> motion;
+    Mark mark() const {
+        return {direct.size(), faces.size(), shadows.size(), glowSprs1.size(),
+                glowSprs2.size()};
+    }
+    void recordMotion(const Mark & from, const sf::Vector2f & delta) {
+        if (delta.x != 0.f || delta.y != 0.f) {
+            motion.push_back({from, mark(), delta});
+        }
+    }
+    // Shifts each object's sprites back towards where they were on the
+    // previous logic tick, t being the fraction of the current tick elapsed
+    void interpolate(float t) {
+        for (const auto & element : motion) {
+            translate(element.begin, element.end, element.delta * (1.f - t));
+        }
+        motion.clear();
+    }
+    void clear() {
+        direct.clear();
+        faces.clear();
+        shadows.clear();
+        glowSprs1.clear();
+        glowSprs2.clear();
+        motion.clear();
+    }
+
+private:
+    void translate(const Mark & from, const Mark & to,
+                   const sf::Vector2f & offset) {
+        for (size_t i = from.direct; i < to.direct; ++i) {
+            direct[i].move(offset);
+        }
+        for (size_t i = from.faces; i < to.faces; ++i) {
+            std::get<0>(faces[i]).move(offset);
+            std::get<1>(faces[i]) += offset.y;
+        }
+        for (size_t i = from.shadows; i < to.shadows; ++i) {
+            std::get<0>(shadows[i]).move(offset);
+        }
+        for (size_t i = from.glowSprs1; i < to.glowSprs1; ++i) {
+            glowSprs1[i].move(offset);
+        }
+        for (size_t i = from.glowSprs2; i < to.glowSprs2; ++i) {
+            glowSprs2[i].move(offset);
+        }
+    }
 };
@@ -15,11 +15,10 @@ class _Laika : public Drawable<_Laika<DrawPolicy>, DrawPolicy>,
 public:
     enum class State { idle, returnToPlayer, approachEnemy };
     using HBox = HitBox<32, 32, 0, -6>;
-    _Laika(const float _xInit, const float _yInit, const sf::Texture & texture,
-           Tile _map[MAP_WIDTH][MAP_HEIGHT])
+    _Laika(const float _xInit, const float _yInit, const sf::Texture & texture)
         : Object(_xInit, _yInit), state(State::idle), idleSheet(texture),
           runSheet(texture), shadow(texture), frameIndex(0), animationTimer(0),
-          currentDir(0.f), recalc(0), map(_map) {
+          currentDir(0.f), recalc(0), pendingPath(0) {
         idleSheet.setPosition(this->getPosition());
         idleSheet.setOrigin(16, 16);
         runSheet.setOrigin(18, 20);
@@ -76,13 +75,12 @@ public:
             } else {
                 auto & enemies = pGame->getEnemyController();
                 std::vector<std::shared_ptr<Object>> enemyVec;
-                const sf::View & cv = pGame->getCamera().getOverworldView();
-                const auto collect = [&cv, &enemyVec](auto & vec) {
-                    for (auto & element : vec) {
-                        if (isWithinView(*element, cv)) {
-                            enemyVec.push_back(element);
-                        }
-                    }
+                auto & culler = pGame->getViewCuller();
+                const auto collect = [&culler, &enemyVec](auto & vec) {
+                    culler.forEachVisible(vec, 128,
+                                          [&enemyVec](const auto & element) {
+                                              enemyVec.push_back(element);
+                                          });
                 };
                 collect(enemies.getCritters());
                 collect(enemies.getScoots());
@@ -140,6 +138,7 @@ public:
             } else {
                 idleSheet.setPosition(position);
                 state = State::idle;
+                cancelPendingPath(pGame);
             }
         } break;
 
@@ -159,10 +158,11 @@ public:
                 state = State::idle;
                 idleSheet.setPosition(this->position);
                 path.clear();
+                cancelPendingPath(pGame);
             } else {
                 float normal = fmax(180.f - (dist + 48.f), 0) / 180.f;
                 approachTarget(elapsedTime, pGame, playerPos,
-                               (1.f - normal) * 2.8);
+                               (1.f - normal) * 2.8, &pGame->getPlayerField());
             }
             runSheet.setPosition(position);
             const float xScale = cos(currentDir);
@@ -179,10 +179,18 @@ public:
         }
     }
 
+    // Heads for destination a tile at a time. With a field that leads there
+    // the path comes off the field, otherwise it's asked of the path queue,
+    // and Laika keeps to the path she has until the new one turns up.
     template <typename Game>
     void approachTarget(const sf::Time & elapsedTime, Game * pGame,
-                        const sf::Vector2f & destination, const float speed) {
+                        const sf::Vector2f & destination, const float speed,
+                        const FlowField * field = nullptr) {
         tileController & tiles = pGame->getTileController();
+        if (pendingPath && pGame->getPathQueue().take(pendingPath, path)) {
+            pendingPath = 0;
+            startPath(tiles);
+        }
         if (path.empty() || recalc == 0) {
             recalc = 8;
             aStrCoordinate origin, target;
@@ -190,14 +198,14 @@ public:
             origin.y = (position.y - tiles.posY) / 26;
             target.x = (tiles.posX - destination.x - 12) / -32;
             target.y = (tiles.posY - destination.y - 32) / -26;
-            if (isTileWalkable(map[target.x][target.y])) {
-                path = astar_path(target, origin, map);
-                path.pop_back();
-                position.x = ((position.x - tiles.posX) / 32) * 32 + tiles.posX;
-                position.y = ((position.y - tiles.posY) / 26) * 26 + tiles.posY;
-                currentDir = atan2(
-                    position.y - (((path.back().y * 26) + 4 + tiles.posY)),
-                    position.x - (((path.back().x * 32) + 4 + tiles.posX)));
+            if (tiles.layers.test(MapLayers::Walkable, target.x, target.y)) {
+                if (field) {
+                    cancelPendingPath(pGame);
+                    field->trace(origin.x, origin.y, path);
+                    startPath(tiles);
+                } else if (!pendingPath) {
+                    pendingPath = pGame->getPathQueue().submit(target, origin);
+                }
             }
         } else {
             position.x -= speed * cos(currentDir) *
@@ -210,13 +218,36 @@ public:
                     8) {
                 recalc--;
                 path.pop_back();
-                currentDir = atan2(
-                    position.y - (((path.back().y * 26) + 4 + tiles.posY)),
-                    position.x - (((path.back().x * 32) + 4 + tiles.posX)));
+                if (!path.empty()) {
+                    currentDir = atan2(
+                        position.y - (((path.back().y * 26) + 4 + tiles.posY)),
+                        position.x - (((path.back().x * 32) + 4 + tiles.posX)));
+                }
             }
         }
     }
 
+    // Sets off along a new path, which starts at the destination and ends on
+    // the tile Laika was on when it was found
+    void startPath(const tileController & tiles) {
+        // Already on the target's tile, nowhere to go until it moves
+        if (path.size() < 2) {
+            path.clear();
+            return;
+        }
+        path.pop_back();
+        currentDir =
+            atan2(position.y - (((path.back().y * 26) + 4 + tiles.posY)),
+                  position.x - (((path.back().x * 32) + 4 + tiles.posX)));
+    }
+
+    template <typename Game> void cancelPendingPath(Game * pGame) {
+        if (pendingPath) {
+            pGame->getPathQueue().cancel(pendingPath);
+            pendingPath = 0;
+        }
+    }
+
 private:
     State state;
     HBox hitBox;
@@ -225,9 +256,10 @@ private:
     sf::Sprite shadow;
     uint8_t frameIndex;
     int64_t animationTimer;
-    Tile (*map)[61];
     std::vector<aStrCoordinate> path;
     float currentDir;
     int recalc;
+    // A path asked for but not found yet, zero for none
+    PathQueue::Handle pendingPath;
     std::weak_ptr<Object> targetEnemy;
 };
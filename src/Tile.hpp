@@ -1,6 +1,9 @@
 #pragma once
 
-enum class Tile {
+#include <cstdint>
+
+// A byte each, a whole map fits in a few kilobytes
+enum class Tile : uint8_t {
     Empty,
     Wall,
     PlateLowerEdge,
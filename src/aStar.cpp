@@ -1,187 +1,480 @@
 #include "aStar.hpp"
 #include <algorithm>
-#include <cmath>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include "mappingFunctions.hpp"
 
-// Calculates a heuristic based on the distance between two nodes
-inline float heuristic(int x1, int x2, int y1, int y2) {
-    return (sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2)));
-}
-
-namespace std {
-template <> struct hash<aStrCoordinate> {
-    inline size_t operator()(const aStrCoordinate & n) const {
-        return n.x * 1812433253 + n.y;
-    }
-};
-}
-
-// Overloaded operator for comparing two nodes
-bool operator!=(const aStrCoordinate & a, const aStrCoordinate & b) {
-    return (a.x != b.x) || (a.y != b.y);
-}
+// What a step costs. Diagonals are cheaper than going straight, so that
+// enemies cut across open ground.
+static const float straightCost = 1.f, diagonalCost = 0.75f;
 
-// Overloaded operator for comparing two nodes
-bool operator==(const aStrCoordinate & a, const aStrCoordinate & b) {
-    return (a.x == b.x) && (a.y == b.y);
+// A lower bound on the cost from one tile to another: every step covers at
+// most a tile along each axis and costs at least a diagonal. Never
+// overestimating is what makes the paths the cheapest ones.
+float heuristic(int x1, int x2, int y1, int y2) {
+    return diagonalCost * std::max(std::abs(x1 - x2), std::abs(y1 - y2));
 }
 
-struct compare {
-    bool operator()(const aStrCoordinate & a, const aStrCoordinate & b) const {
-        return a.f < b.f;
+// Calls hook(xOff, yOff, cost) for each step that can be taken from (x, y)
+template <typename F>
+static void forEachStep(const MapLayers & layers, int x, int y,
+                        const F & hook) {
+    const uint8_t open = layers.neighbours(MapLayers::Walkable, x, y);
+    if (open & MapLayers::West) {
+        hook(-1, 0, straightCost);
     }
-};
+    if (open & MapLayers::East) {
+        hook(1, 0, straightCost);
+    }
+    if (open & MapLayers::North) {
+        hook(0, -1, straightCost);
+    }
+    if (open & MapLayers::South) {
+        hook(0, 1, straightCost);
+    }
+    // Diagonals only when all four sides are open, so that paths never cut
+    // a corner
+    static const uint8_t sides = MapLayers::North | MapLayers::East |
+                                 MapLayers::South | MapLayers::West;
+    if ((open & sides) == sides) {
+        if (open & MapLayers::NorthEast) {
+            hook(1, -1, diagonalCost);
+        }
+        if (open & MapLayers::SouthEast) {
+            hook(1, 1, diagonalCost);
+        }
+        if (open & MapLayers::SouthWest) {
+            hook(-1, 1, diagonalCost);
+        }
+        if (open & MapLayers::NorthWest) {
+            hook(-1, -1, diagonalCost);
+        }
+    }
+}
 
 // A function to return a list of adjacent empty squares
 std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
                                         aStrCoordinate & target,
-                                        Tile map[MAP_WIDTH][MAP_HEIGHT]) {
-    // Declare a vector of adjacent coordinates to return
+                                        const MapLayers & layers) {
     std::vector<aStrCoordinate> adjacentTiles;
-    bool diagonalMove = true;
-    if (isTileWalkable(map[coord.x - 1][coord.y])) {
+    forEachStep(layers, coord.x, coord.y, [&](int xOff, int yOff, float cost) {
         aStrCoordinate newCoord;
-        newCoord.g = coord.g + 1;
-        newCoord.x = coord.x - 1;
-        newCoord.y = coord.y;
+        newCoord.g = coord.g + cost;
+        newCoord.x = coord.x + xOff;
+        newCoord.y = coord.y + yOff;
         newCoord.f =
             newCoord.g + heuristic(newCoord.x, target.x, newCoord.y, target.y);
         adjacentTiles.push_back(newCoord);
-    } else {
-        diagonalMove = false;
+    });
+    return adjacentTiles;
+}
+
+namespace {
+const int nodeCount = MAP_WIDTH * MAP_HEIGHT;
+
+// A bit per tile of the map, tiles numbered a column at a time like
+// MapLayers
+class NodeSet {
+public:
+    void clear() { std::memset(words, 0, sizeof(words)); }
+    bool test(int node) const { return (words[node >> 6] >> (node & 63)) & 1; }
+    void set(int node) { words[node >> 6] |= uint64_t(1) << (node & 63); }
+
+private:
+    uint64_t words[(nodeCount + 63) / 64];
+};
+}
+
+// Everything a search needs, sized for the whole map up front. Only the two
+// sets get cleared between searches, the rest of a node's state is written
+// when it's first opened. A search can be run a bit at a time.
+class PathFinder {
+public:
+    // Starts a search out from origin, towards target if there is one,
+    // otherwise to everywhere origin reaches
+    void begin(const aStrCoordinate & origin, const aStrCoordinate * target);
+    // Expands up to budget more nodes and returns how many it did
+    int run(const MapLayers & layers, int budget);
+    bool isFinished() const { return finished; }
+    // Once finished, writes the path to the target into path, or to the
+    // closed tile nearest it as the crow flies if it wasn't reached, and
+    // returns whether it was
+    bool getPath(std::vector<aStrCoordinate> & path) const;
+    bool search(const aStrCoordinate & origin, const aStrCoordinate & target,
+                const MapLayers & layers, std::vector<aStrCoordinate> & path);
+    // Searches everywhere origin reaches, and writes each tile's cost from
+    // origin and the tile before it on the way, or infinity and the tile
+    // itself where it doesn't reach
+    void flood(const aStrCoordinate & origin, const MapLayers & layers,
+               float * costs, uint16_t * parents);
+
+private:
+    float g[nodeCount], f[nodeCount];
+    uint16_t parent[nodeCount];
+    // A binary min heap of the open nodes by f, and where each one is in it
+    uint16_t heap[nodeCount], heapIndex[nodeCount];
+    int heapSize;
+    NodeSet open, closed;
+    int start, goal, targetX, targetY;
+    int nearest, nearestDistance;
+    bool finished;
+    // A lower bound on the cost to the target, none without one, which
+    // makes the search Dijkstra's algorithm
+    float estimate(int x, int y) const {
+        return goal == -1 ? 0.f : heuristic(x, targetX, y, targetY);
     }
-    if (isTileWalkable(map[coord.x + 1][coord.y])) {
-        aStrCoordinate newCoord;
-        newCoord.g = coord.g + 1;
-        newCoord.x = coord.x + 1;
-        newCoord.y = coord.y;
-        newCoord.f =
-            newCoord.g + heuristic(newCoord.x, target.x, newCoord.y, target.y);
-        adjacentTiles.push_back(newCoord);
-    } else {
-        diagonalMove = false;
+    // Lower f first, and of two equal ones the node further along, which
+    // is usually closer to the target
+    bool before(int a, int b) const {
+        return f[a] < f[b] || (f[a] == f[b] && g[a] > g[b]);
     }
-    if (isTileWalkable(map[coord.x][coord.y - 1])) {
-        aStrCoordinate newCoord;
-        newCoord.g = coord.g + 1;
-        newCoord.x = coord.x;
-        newCoord.y = coord.y - 1;
-        newCoord.f =
-            newCoord.g + heuristic(newCoord.x, target.x, newCoord.y, target.y);
-        adjacentTiles.push_back(newCoord);
-    } else {
-        diagonalMove = false;
+    void place(int at, int node) {
+        heap[at] = static_cast<uint16_t>(node);
+        heapIndex[node] = static_cast<uint16_t>(at);
     }
-    if (isTileWalkable(map[coord.x][coord.y + 1])) {
-        aStrCoordinate newCoord;
-        newCoord.g = coord.g + 1;
-        newCoord.x = coord.x;
-        newCoord.y = coord.y + 1;
-        newCoord.f =
-            newCoord.g + heuristic(newCoord.x, target.x, newCoord.y, target.y);
-        adjacentTiles.push_back(newCoord);
-    } else {
-        diagonalMove = false;
-    }
-    if (diagonalMove) {
-        if (isTileWalkable(map[coord.x + 1][coord.y + 1])) {
-            aStrCoordinate newCoord;
-            newCoord.g = coord.g + 0.75;
-            newCoord.x = coord.x + 1;
-            newCoord.y = coord.y + 1;
-            newCoord.f = newCoord.g +
-                         heuristic(newCoord.x, target.x, newCoord.y, target.y);
-            adjacentTiles.push_back(newCoord);
-        }
-        if (isTileWalkable(map[coord.x - 1][coord.y + 1])) {
-            aStrCoordinate newCoord;
-            newCoord.g = coord.g + 0.75;
-            newCoord.x = coord.x - 1;
-            newCoord.y = coord.y + 1;
-            newCoord.f = newCoord.g +
-                         heuristic(newCoord.x, target.x, newCoord.y, target.y);
-            adjacentTiles.push_back(newCoord);
-        }
-        if (isTileWalkable(map[coord.x - 1][coord.y - 1])) {
-            aStrCoordinate newCoord;
-            newCoord.g = coord.g + 0.75;
-            newCoord.x = coord.x - 1;
-            newCoord.y = coord.y - 1;
-            newCoord.f = newCoord.g +
-                         heuristic(newCoord.x, target.x, newCoord.y, target.y);
-            adjacentTiles.push_back(newCoord);
-        }
-        if (isTileWalkable(map[coord.x + 1][coord.y + 1])) {
-            aStrCoordinate newCoord;
-            newCoord.g = coord.g + 0.75;
-            newCoord.x = coord.x + 1;
-            newCoord.y = coord.y + 1;
-            newCoord.f = newCoord.g +
-                         heuristic(newCoord.x, target.x, newCoord.y, target.y);
+    void siftUp(int at) {
+        const int node = heap[at];
+        while (at > 0 && before(node, heap[(at - 1) / 2])) {
+            place(at, heap[(at - 1) / 2]);
+            at = (at - 1) / 2;
         }
+        place(at, node);
     }
-    return adjacentTiles;
+    void siftDown(int at) {
+        const int node = heap[at];
+        for (int child = 2 * at + 1; child < heapSize; child = 2 * at + 1) {
+            if (child + 1 < heapSize && before(heap[child + 1], heap[child])) {
+                ++child;
+            }
+            if (!before(heap[child], node)) {
+                break;
+            }
+            place(at, heap[child]);
+            at = child;
+        }
+        place(at, node);
+    }
+    void push(int node) {
+        place(heapSize++, node);
+        siftUp(heapSize - 1);
+    }
+    int pop() {
+        const int node = heap[0];
+        if (--heapSize > 0) {
+            place(0, heap[heapSize]);
+            siftDown(0);
+        }
+        return node;
+    }
+};
+
+void PathFinder::begin(const aStrCoordinate & origin,
+                       const aStrCoordinate * target) {
+    start = origin.x * MAP_HEIGHT + origin.y;
+    goal = target ? target->x * MAP_HEIGHT + target->y : -1;
+    targetX = target ? target->x : 0;
+    targetY = target ? target->y : 0;
+    open.clear();
+    closed.clear();
+    heapSize = 0;
+    g[start] = 0.f;
+    f[start] = estimate(origin.x, origin.y);
+    parent[start] = static_cast<uint16_t>(start);
+    open.set(start);
+    push(start);
+    nearest = start;
+    nearestDistance = 0x7fffffff;
+    finished = false;
 }
 
-bool contains(std::vector<aStrCoordinate> & closed, aStrCoordinate & node) {
-    for (auto element : closed) {
-        if (element.x == node.x && element.y == node.y) {
-            return true;
+int PathFinder::run(const MapLayers & layers, int budget) {
+    int expanded = 0;
+    while (!finished && expanded < budget) {
+        if (heapSize == 0) {
+            finished = true;
+            break;
+        }
+        const int node = pop();
+        const int x = node / MAP_HEIGHT, y = node % MAP_HEIGHT;
+        closed.set(node);
+        ++expanded;
+        if (goal != -1) {
+            const int distance = (x - targetX) * (x - targetX) +
+                                 (y - targetY) * (y - targetY);
+            if (distance < nearestDistance) {
+                nearest = node;
+                nearestDistance = distance;
+            }
+        }
+        if (node == goal) {
+            finished = true;
+            break;
         }
+        // The heuristic is consistent, so a closed node already has its
+        // cheapest g and never needs opening again
+        forEachStep(layers, x, y, [&](int xOff, int yOff, float cost) {
+            const int next = node + xOff * MAP_HEIGHT + yOff;
+            if (closed.test(next)) {
+                return;
+            }
+            const float nextG = g[node] + cost;
+            if (!open.test(next)) {
+                open.set(next);
+                g[next] = nextG;
+                f[next] = nextG + estimate(x + xOff, y + yOff);
+                parent[next] = static_cast<uint16_t>(node);
+                push(next);
+            } else if (nextG < g[next]) {
+                f[next] += nextG - g[next];
+                g[next] = nextG;
+                parent[next] = static_cast<uint16_t>(node);
+                siftUp(heapIndex[next]);
+            }
+        });
     }
+    return expanded;
+}
 
-    return false;
+bool PathFinder::getPath(std::vector<aStrCoordinate> & path) const {
+    path.clear();
+    for (int node = nearest;; node = parent[node]) {
+        aStrCoordinate step;
+        step.x = node / MAP_HEIGHT;
+        step.y = node % MAP_HEIGHT;
+        step.g = g[node];
+        step.f = f[node];
+        path.push_back(step);
+        if (node == start) {
+            break;
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return nearest == goal;
+}
+
+bool PathFinder::search(const aStrCoordinate & origin,
+                        const aStrCoordinate & target,
+                        const MapLayers & layers,
+                        std::vector<aStrCoordinate> & path) {
+    begin(origin, &target);
+    // Every node gets expanded at most once
+    run(layers, nodeCount + 1);
+    return getPath(path);
+}
+
+void PathFinder::flood(const aStrCoordinate & origin,
+                       const MapLayers & layers, float * costs,
+                       uint16_t * parents) {
+    begin(origin, nullptr);
+    run(layers, nodeCount + 1);
+    for (int node = 0; node < nodeCount; ++node) {
+        if (closed.test(node)) {
+            costs[node] = g[node];
+            parents[node] = parent[node];
+        } else {
+            costs[node] = std::numeric_limits<float>::infinity();
+            parents[node] = static_cast<uint16_t>(node);
+        }
+    }
+}
+
+// One per thread, so that searching stays safe from any thread
+static thread_local PathFinder pathFinder;
+
+bool astar_path(const aStrCoordinate & origin, const aStrCoordinate & target,
+                const MapLayers & layers, std::vector<aStrCoordinate> & path) {
+    return pathFinder.search(origin, target, layers, path);
 }
 
-std::vector<aStrCoordinate> reconstruct_path(
-    aStrCoordinate start, aStrCoordinate goal,
-    std::unordered_map<aStrCoordinate, aStrCoordinate> & came_from) {
+std::vector<aStrCoordinate> astar_path(const aStrCoordinate & origin,
+                                       const aStrCoordinate & target,
+                                       const MapLayers & layers) {
     std::vector<aStrCoordinate> path;
-    aStrCoordinate current = goal;
-    path.push_back(current);
-    while (current != start) {
-        current = came_from[current];
-        path.push_back(current);
+    astar_path(origin, target, layers, path);
+    return path;
+}
+
+FlowField::FlowField() : goal(-1) {}
+
+void FlowField::update(int x, int y, const MapLayers & layers) {
+    if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT ||
+        x * MAP_HEIGHT + y == goal ||
+        !layers.test(MapLayers::Walkable, x, y)) {
+        return;
+    }
+    goal = x * MAP_HEIGHT + y;
+    pathFinder.flood({x, y, 0.f, 0.f}, layers, costs, steps);
+}
+
+void FlowField::reset() { goal = -1; }
+
+bool FlowField::reaches(int x, int y) const {
+    return goal != -1 && x >= 0 && x < MAP_WIDTH && y >= 0 &&
+           y < MAP_HEIGHT &&
+           costs[x * MAP_HEIGHT + y] != std::numeric_limits<float>::infinity();
+}
+
+bool FlowField::isGoal(int x, int y) const {
+    return x * MAP_HEIGHT + y == goal;
+}
+
+aStrCoordinate FlowField::next(int x, int y) const {
+    const int node = steps[x * MAP_HEIGHT + y];
+    return {node / MAP_HEIGHT, node % MAP_HEIGHT, costs[node], costs[node]};
+}
+
+bool FlowField::trace(int x, int y, std::vector<aStrCoordinate> & path) const {
+    path.clear();
+    if (!reaches(x, y)) {
+        return false;
+    }
+    const float cost = costs[x * MAP_HEIGHT + y];
+    path.push_back({x, y, cost, cost});
+    while (!isGoal(path.back().x, path.back().y)) {
+        path.push_back(next(path.back().x, path.back().y));
     }
     std::reverse(path.begin(), path.end());
-    return path;
+    return true;
 }
 
-std::vector<aStrCoordinate> astar_path(aStrCoordinate & origin,
-                                       aStrCoordinate & target,
-                                       Tile map[MAP_WIDTH][MAP_HEIGHT]) {
-    std::vector<aStrCoordinate> closed;
-    std::vector<aStrCoordinate> open = {origin};
-    origin.g = 0;
-    origin.f = heuristic(origin.x, target.x, origin.y, target.y);
-    std::make_heap(open.begin(), open.end(), compare());
-    std::unordered_map<aStrCoordinate, aStrCoordinate> cameFrom;
-    cameFrom[origin] = origin;
-    do {
-        aStrCoordinate currentNode = open.back();
-        closed.push_back(currentNode);
-        open.pop_back();
-        for (auto element : closed) {
-            if (element.x == target.x && element.y == target.y) {
-                return reconstruct_path(origin, target, cameFrom);
-            }
+PathCache::PathCache() : clock(0), hits(0), misses(0) {}
+
+static uint16_t tileOf(const aStrCoordinate & coord) {
+    return static_cast<uint16_t>(coord.x * MAP_HEIGHT + coord.y);
+}
+
+bool PathCache::find(const aStrCoordinate & origin,
+                     const aStrCoordinate & target, const MapLayers & layers,
+                     std::vector<aStrCoordinate> & path) {
+    bool reached;
+    if (!lookup(origin, target, layers, path, reached)) {
+        reached = astar_path(origin, target, layers, path);
+        store(origin, target, layers, path, reached);
+    }
+    return reached;
+}
+
+bool PathCache::lookup(const aStrCoordinate & origin,
+                       const aStrCoordinate & target, const MapLayers & layers,
+                       std::vector<aStrCoordinate> & path, bool & reached) {
+    const uint32_t generation = layers.getGeneration();
+    const uint16_t from = tileOf(origin), to = tileOf(target);
+    for (auto & entry : entries) {
+        if (entry.generation == generation && entry.origin == from &&
+            entry.target == to) {
+            ++hits;
+            entry.lastUsed = ++clock;
+            path = entry.path;
+            reached = entry.reached;
+            return true;
         }
-        std::vector<aStrCoordinate> adjacentTiles =
-            getAdjacent(currentNode, target, map);
-        for (auto & element : adjacentTiles) {
-            if (contains(closed, element)) {
+    }
+    ++misses;
+    return false;
+}
+
+void PathCache::store(const aStrCoordinate & origin,
+                      const aStrCoordinate & target, const MapLayers & layers,
+                      const std::vector<aStrCoordinate> & path, bool reached) {
+    Entry * oldest = &entries[0];
+    for (auto & entry : entries) {
+        // Unused entries have a generation of zero and go first
+        if (entry.generation == 0 ||
+            (oldest->generation != 0 && entry.lastUsed < oldest->lastUsed)) {
+            oldest = &entry;
+        }
+    }
+    oldest->generation = layers.getGeneration();
+    oldest->origin = tileOf(origin);
+    oldest->target = tileOf(target);
+    oldest->reached = reached;
+    oldest->lastUsed = ++clock;
+    oldest->path = path;
+}
+
+void PathCache::clear() {
+    for (auto & entry : entries) {
+        entry.generation = 0;
+    }
+}
+
+uint64_t PathCache::getHits() const { return hits; }
+
+uint64_t PathCache::getMisses() const { return misses; }
+
+PathQueue::PathQueue()
+    : lastHandle(0), searching(0), finder(new PathFinder) {}
+
+PathQueue::~PathQueue() {}
+
+PathQueue::Handle PathQueue::submit(const aStrCoordinate & origin,
+                                    const aStrCoordinate & target) {
+    if (++lastHandle == 0) {
+        ++lastHandle;
+    }
+    requests.push_back({lastHandle, origin, target, false, {}});
+    return lastHandle;
+}
+
+void PathQueue::service(const MapLayers & layers, PathCache & cache,
+                        int budget) {
+    for (auto & request : requests) {
+        if (request.ready) {
+            continue;
+        }
+        if (budget <= 0) {
+            return;
+        }
+        if (searching != request.handle) {
+            bool reached;
+            if (cache.lookup(request.origin, request.target, layers,
+                             request.path, reached)) {
+                request.ready = true;
                 continue;
             }
-            if (!contains(open, element)) {
-                open.push_back(element);
-                cameFrom[element] = closed.back();
-                std::push_heap(open.begin(), open.end(), compare());
+            finder->begin(request.origin, &request.target);
+            searching = request.handle;
+        }
+        budget -= finder->run(layers, budget);
+        if (!finder->isFinished()) {
+            return;
+        }
+        const bool reached = finder->getPath(request.path);
+        cache.store(request.origin, request.target, layers, request.path,
+                    reached);
+        request.ready = true;
+        searching = 0;
+    }
+}
+
+bool PathQueue::take(Handle handle, std::vector<aStrCoordinate> & path) {
+    for (auto it = requests.begin(); it != requests.end(); ++it) {
+        if (it->handle == handle) {
+            if (!it->ready) {
+                return false;
             }
+            std::swap(path, it->path);
+            requests.erase(it);
+            return true;
         }
+    }
+    return false;
+}
+
+void PathQueue::cancel(Handle handle) {
+    for (auto it = requests.begin(); it != requests.end(); ++it) {
+        if (it->handle == handle) {
+            requests.erase(it);
+            break;
+        }
+    }
+    if (searching == handle) {
+        searching = 0;
+    }
+}
 
-    } while (!open.empty());
-    return closed;
+void PathQueue::clear() {
+    requests.clear();
+    searching = 0;
 }
@@ -1,11 +1,10 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <stdint.h>
 #include <vector>
-#include "Tile.hpp"
-
-#define MAP_WIDTH 61
-#define MAP_HEIGHT 61
+#include "mapLayers.hpp"
 
 // A simple structure to hold ordered pairs
 struct aStrCoordinate {
@@ -13,13 +12,134 @@ struct aStrCoordinate {
     float f, g;
 };
 
-// Define a class for a node
-std::vector<aStrCoordinate> astar_path(aStrCoordinate &, aStrCoordinate &,
-                                       Tile map[MAP_WIDTH][MAP_HEIGHT]);
+// Finds a cheapest path over the walkable tiles from origin to target and
+// writes it into path, origin first, with each step's g the cost so far.
+// Returns false if target can't be reached, and path then leads to the
+// reached tile closest to it instead. Apart from growing path the search
+// doesn't allocate, so callers that keep their path around pay nothing.
+bool astar_path(const aStrCoordinate & origin, const aStrCoordinate & target,
+                const MapLayers & layers, std::vector<aStrCoordinate> & path);
 
-bool contains(std::vector<aStrCoordinate> &, aStrCoordinate &);
+std::vector<aStrCoordinate> astar_path(const aStrCoordinate &,
+                                       const aStrCoordinate &,
+                                       const MapLayers &);
 
+// The tiles one step away from coord, with f and g worked out towards target
 std::vector<aStrCoordinate> getAdjacent(aStrCoordinate &, aStrCoordinate &,
-                                        Tile map[MAP_WIDTH][MAP_HEIGHT]);
+                                        const MapLayers &);
 
 float heuristic(int, int, int, int);
+
+//
+// Where the cheapest path from every tile to one goal tile goes next, from a
+// single search out of the goal. It takes the same steps as astar_path(goal,
+// tile) walked backwards, so everything heading for the same tile can share
+// one field and read its next step off it instead of searching.
+//
+class FlowField {
+public:
+    FlowField();
+    // Searches out from (x, y), unless the field already leads there. Off the
+    // map or unwalkable, the field keeps leading where it did.
+    void update(int x, int y, const MapLayers & layers);
+    // Forgets the goal, for when the map changes
+    void reset();
+    bool reaches(int x, int y) const;
+    bool isGoal(int x, int y) const;
+    // The tile after (x, y) on the way to the goal, with f and g the cost
+    // from there. Only for tiles that reach the goal.
+    aStrCoordinate next(int x, int y) const;
+    // Writes the path from (x, y) into path the way astar_path() would from
+    // the goal, goal first. Returns false and leaves path empty if (x, y)
+    // doesn't reach the goal.
+    bool trace(int x, int y, std::vector<aStrCoordinate> & path) const;
+
+private:
+    static const int nodeCount = MAP_WIDTH * MAP_HEIGHT;
+    // Tiles are numbered a column at a time, -1 for no goal
+    int goal;
+    float costs[nodeCount];
+    uint16_t steps[nodeCount];
+};
+
+//
+// The last few paths found, for whoever keeps asking for the same one, like
+// Laika chasing an enemy that stands still. Paths are keyed by their two
+// tiles and the map's generation, so one from an earlier map never comes
+// back, and the least recently used one makes room for a new one.
+//
+class PathCache {
+public:
+    PathCache();
+    // Same as astar_path(), without the search when the path is cached
+    bool find(const aStrCoordinate & origin, const aStrCoordinate & target,
+              const MapLayers & layers, std::vector<aStrCoordinate> & path);
+    // Copies a cached path into path and whether it reached target, or
+    // returns false if there isn't one
+    bool lookup(const aStrCoordinate & origin, const aStrCoordinate & target,
+                const MapLayers & layers, std::vector<aStrCoordinate> & path,
+                bool & reached);
+    // Remembers a path found some other way
+    void store(const aStrCoordinate & origin, const aStrCoordinate & target,
+               const MapLayers & layers,
+               const std::vector<aStrCoordinate> & path, bool reached);
+    // Forgets every path, for when the map changes. Keeps the counts.
+    void clear();
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+private:
+    struct Entry {
+        // Zero for an unused entry, maps start at one
+        uint32_t generation = 0;
+        uint16_t origin, target;
+        bool reached;
+        // When it was last found or stored, by the cache's own clock
+        uint64_t lastUsed;
+        std::vector<aStrCoordinate> path;
+    };
+    static const int capacity = 16;
+    std::array<Entry, capacity> entries;
+    uint64_t clock, hits, misses;
+};
+
+class PathFinder;
+
+//
+// Searches asked for now and carried out later, a bounded number of tiles
+// per tick, so that several things wanting a path at once don't make for a
+// slow tick. The asker gets a handle back, carries on with the path it has,
+// and picks the new one up with take() once it's there. Paths come from and
+// go into a PathCache, so asking for a cached one costs no search.
+//
+class PathQueue {
+public:
+    // Zero is never a request
+    using Handle = uint32_t;
+    PathQueue();
+    ~PathQueue();
+    Handle submit(const aStrCoordinate & origin, const aStrCoordinate & target);
+    // Works through the requests in the order they came in, expanding at
+    // most budget tiles. A search that doesn't finish carries on next time.
+    void service(const MapLayers & layers, PathCache & cache, int budget);
+    // Once the path is ready, swaps it into path, forgets the request and
+    // returns true
+    bool take(Handle handle, std::vector<aStrCoordinate> & path);
+    void cancel(Handle handle);
+    // Forgets every request, for when the map changes
+    void clear();
+
+private:
+    struct Request {
+        Handle handle;
+        aStrCoordinate origin, target;
+        bool ready;
+        std::vector<aStrCoordinate> path;
+    };
+    std::vector<Request> requests;
+    Handle lastHandle;
+    // The request being searched for, zero between searches
+    Handle searching;
+    // A search of its own, which has to last from one service() to the next
+    std::unique_ptr<PathFinder> finder;
+};
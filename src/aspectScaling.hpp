@@ -5,9 +5,9 @@
 #include <exception>
 #include <json.hpp>
 
-inline sf::Vector2f getDrawableArea(const nlohmann::json & configJSON) {
+inline sf::Vector2f getDrawableArea(const nlohmann::json & configJSON,
+                                    const sf::VideoMode & screenSize) {
     sf::Vector2f drawableAreaSize = {};
-    auto screenSize = sf::VideoMode::getDesktopMode();
     const float aspectRatio =
         (float)screenSize.width / (float)screenSize.height;
     try {
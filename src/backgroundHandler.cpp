@@ -43,7 +43,8 @@ void backgroundHandler::drawForeground(sf::RenderTexture & window) {
 
 void backgroundHandler::drawBackground(sf::RenderTexture & target,
                                        const sf::View & worldView,
-                                       const Camera & camera) {
+                                       const sf::View & cameraView,
+                                       const sf::Vector2f & cameraOffset) {
     switch (workingSet) {
     case 0:
         foregroundTreesSpr.setPosition(windowW / 2 + xOffset - 108,
@@ -52,7 +53,6 @@ void backgroundHandler::drawBackground(sf::RenderTexture & target,
         break;
 
     default: {
-        const sf::Vector2f cameraOffset = camera.getOffsetFromTarget();
         static const float visibleArea = 0.75f;
         static const float borderAmt = 0.115f;
         bkgSprite.setPosition(
@@ -61,69 +61,69 @@ void backgroundHandler::drawBackground(sf::RenderTexture & target,
         target.draw(bkgSprite);
     } break;
     }
-    target.setView(camera.getOverworldView());
+    target.setView(cameraView);
     if (workingSet != 0) {
         for (int i = 0; i < STARMAP_SIZE; i++) {
             for (int j = 0; j < STARMAP_SIZE; j++) {
                 if (stars[i][j].getPosition().x <
-                    camera.getOverworldView().getCenter().x -
-                        camera.getOverworldView().getSize().x / 2 - 128) {
+                    cameraView.getCenter().x -
+                        cameraView.getSize().x / 2 - 128) {
                     stars[i][j].setPosition(stars[i][j].getPosition().x +
                                                 128 * STARMAP_SIZE,
                                             stars[i][j].getPosition().y);
                 }
 
                 if (stars[i][j].getPosition().x >
-                    camera.getOverworldView().getCenter().x +
-                        camera.getOverworldView().getSize().x / 2 + 128) {
+                    cameraView.getCenter().x +
+                        cameraView.getSize().x / 2 + 128) {
                     stars[i][j].setPosition(stars[i][j].getPosition().x -
                                                 128 * STARMAP_SIZE,
                                             stars[i][j].getPosition().y);
                 }
 
                 if (stars[i][j].getPosition().y >
-                    camera.getOverworldView().getCenter().y +
-                        camera.getOverworldView().getSize().y / 2 + 128) {
+                    cameraView.getCenter().y +
+                        cameraView.getSize().y / 2 + 128) {
                     stars[i][j].setPosition(stars[i][j].getPosition().x,
                                             stars[i][j].getPosition().y -
                                                 128 * STARMAP_SIZE);
                 }
 
                 if (stars[i][j].getPosition().y <
-                    camera.getOverworldView().getCenter().y -
-                        camera.getOverworldView().getSize().y / 2 - 128) {
+                    cameraView.getCenter().y -
+                        cameraView.getSize().y / 2 - 128) {
                     stars[i][j].setPosition(stars[i][j].getPosition().x,
                                             stars[i][j].getPosition().y +
                                                 128 * STARMAP_SIZE);
                 }
 
                 if (starsFar[i][j].getPosition().x <
-                    camera.getOverworldView().getCenter().x -
-                        camera.getOverworldView().getSize().x / 2 - 128) {
+                    cameraView.getCenter().x -
+                        cameraView.getSize().x / 2 - 128) {
                     starsFar[i][j].setPosition(starsFar[i][j].getPosition().x +
                                                    128 * STARMAP_SIZE,
                                                starsFar[i][j].getPosition().y);
                 }
 
                 if (starsFar[i][j].getPosition().x >
-                    camera.getOverworldView().getCenter().x +
-                        camera.getOverworldView().getSize().x / 2 + 128) {
+                    cameraView.getCenter().x +
+                        cameraView.getSize().x / 2 + 128) {
                     starsFar[i][j].setPosition(starsFar[i][j].getPosition().x -
                                                    128 * STARMAP_SIZE,
                                                starsFar[i][j].getPosition().y);
                 }
 
                 if (starsFar[i][j].getPosition().y >
-                    camera.getOverworldView().getCenter().y +
-                        camera.getOverworldView().getSize().y / 2 + 128) {
+                    cameraView.getCenter().y +
+                        cameraView.getSize().y / 2 + 128) {
                     starsFar[i][j].setPosition(starsFar[i][j].getPosition().x,
                                                starsFar[i][j].getPosition().y -
                                                    128 * STARMAP_SIZE);
                 }
 
                 if (starsFar[i][j].getPosition().y <
-                    camera.getOverworldView().getCenter().y -
-                        camera.getOverworldView().getSize().y / 2 - 128) {
+                    cameraView.getCenter().y -
+                        cameraView.getSize().y / 2 - 128) {
                     starsFar[i][j].setPosition(starsFar[i][j].getPosition().x,
                                                starsFar[i][j].getPosition().y +
                                                    128 * STARMAP_SIZE);
@@ -1,5 +1,4 @@
 #pragma once
-#include "camera.hpp"
 #include "resourceHandler.hpp"
 #include <SFML/Graphics.hpp>
 
@@ -7,10 +6,7 @@
 
 class backgroundHandler {
 private:
-    sf::Texture foregroundTreesTxtr;
     sf::Sprite foregroundTreesSpr;
-    sf::Texture bkgStars;
-    sf::Texture bkgStarsFar;
     sf::Sprite bkgSprite;
     sf::Sprite stars[STARMAP_SIZE][STARMAP_SIZE];
     sf::Sprite starsFar[STARMAP_SIZE][STARMAP_SIZE];
@@ -23,11 +19,11 @@ private:
     float windowW;
     float windowH;
     unsigned char workingSet;
-    sf::RenderTexture rt;
 
 public:
     backgroundHandler();
-    void drawBackground(sf::RenderTexture &, const sf::View &, const Camera &);
+    void drawBackground(sf::RenderTexture &, const sf::View &, const sf::View &,
+                        const sf::Vector2f &);
     void drawForeground(sf::RenderTexture &);
     void setOffset(float, float);
     void setPosition(float, float);
@@ -0,0 +1,446 @@
+#include "benchmarks.hpp"
+#include "alias.hpp"
+#include "enemyController.hpp"
+#include "framework/boxBatch.hpp"
+#include "framework/framework.hpp"
+#include "framework/spatialHash.hpp"
+#include "jumpPoints.hpp"
+#include "levelBlueprint.hpp"
+#include "rng.hpp"
+#include "tileController.hpp"
+#include "viewCuller.hpp"
+#include "wallCollision.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+// Keeps the optimizer from throwing away work whose result nobody reads
+static volatile uint64_t sink;
+
+// Runs work rounds times and returns the average nanoseconds per call
+template <typename F>
+static double timeRounds(unsigned rounds, const F & work) {
+    uint64_t total = 0;
+    const time_point start = high_resolution_clock::now();
+    for (unsigned round = 0; round < rounds; ++round) {
+        total += work();
+    }
+    const duration elapsed = high_resolution_clock::now() - start;
+    sink = total;
+    return elapsed.count() * 1e9 / rounds;
+}
+
+// Player shots against enemies, spread over about a screen's worth of space,
+// one box at a time through HitBox::overlapping() and then a BoxBatch at a
+// time
+static bool benchOverlap(unsigned rounds) {
+    using ShotBox = HitBox<12, 12, 2, 2>;
+    using EnemyBox = HitBox<12, 12, 4, -3>;
+    std::cout << "overlap: "
+#if defined(__AVX__)
+              << "AVX"
+#elif defined(__SSE2__) || defined(_M_X64)
+              << "SSE2"
+#else
+              << "scalar"
+#endif
+              << " kernel, ns per shot-enemy test" << std::endl;
+    std::cout << std::setw(8) << "shots" << std::setw(9) << "enemies"
+              << std::setw(10) << "scalar" << std::setw(10) << "batched"
+              << std::setw(9) << "speedup" << std::endl;
+    for (size_t shotCount : {8, 32, 128}) {
+        for (size_t enemyCount : {4, 16, 64}) {
+            std::vector<ShotBox> shots(shotCount);
+            std::vector<EnemyBox> enemies(enemyCount);
+            BoxBatch shotBatch;
+            for (auto & shot : shots) {
+                shot.setPosition(rng::random<480>(), rng::random<270>());
+                shotBatch.push(shot);
+            }
+            for (auto & enemy : enemies) {
+                enemy.setPosition(rng::random<480>(), rng::random<270>());
+            }
+            const double scalar = timeRounds(rounds, [&] {
+                uint64_t hits = 0;
+                for (auto & enemy : enemies) {
+                    for (auto & shot : shots) {
+                        hits += enemy.overlapping(shot);
+                    }
+                }
+                return hits;
+            });
+            const double batched = timeRounds(rounds, [&] {
+                uint64_t hits = 0;
+                for (auto & enemy : enemies) {
+                    shotBatch.forEachOverlapping(
+                        enemy.getXPos(), enemy.getYPos(), enemy.getWidth(),
+                        enemy.getHeight(), 0, shots.size(),
+                        [&hits](size_t) { ++hits; });
+                }
+                return hits;
+            });
+            const double tests = double(shotCount * enemyCount);
+            std::cout << std::setw(8) << shotCount << std::setw(9)
+                      << enemyCount << std::fixed << std::setprecision(3)
+                      << std::setw(10) << scalar / tests << std::setw(10)
+                      << batched / tests << std::setprecision(2)
+                      << std::setw(8) << scalar / batched << 'x'
+                      << std::endl;
+        }
+    }
+    return true;
+}
+
+// Same as checks.cpp, a generated level placed the way a game would
+static void loadLevel(tileController & tiles) {
+    tiles.clear();
+    tiles.rebuild(std::move(*buildLevel(false)));
+    tiles.setPosition(400 + rng::random<100>() / 100.f,
+                      234 + rng::random<100>() / 100.f);
+}
+
+// A random spot somewhere on the level
+static sf::Vector2f randomSpot(const tileController & tiles) {
+    return {tiles.posX + rng::random(61 * 32) + rng::random<1000>() / 1000.f,
+            tiles.posY + rng::random(61 * 26) + rng::random<1000>() / 1000.f};
+}
+
+static void printSpeedup(double before, double after) {
+    std::cout << std::fixed << std::setprecision(1) << std::setw(10)
+              << before << std::setw(10) << after << std::setprecision(2)
+              << std::setw(8) << before / after << 'x' << std::endl;
+}
+
+// Wall probes and sight lines on generated levels, checking every wall like
+// the game used to against looking up the tile grid. Half the probes are
+// right next to a wall, where the answers are interesting.
+static bool benchWalls(unsigned rounds) {
+    static const unsigned levels = 3, probeCount = 256;
+    tileController tiles;
+    std::vector<sf::Vector2f> probes, ends;
+    bool agreed = true;
+    std::cout << "walls: ns per query" << std::endl;
+    std::cout << std::setw(6) << "level" << std::setw(7) << "walls"
+              << std::setw(8) << "query" << std::setw(10) << "scan"
+              << std::setw(10) << "grid" << std::setw(9) << "speedup"
+              << std::endl;
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        probes.clear();
+        ends.clear();
+        for (unsigned i = 0; i < probeCount; ++i) {
+            sf::Vector2f probe = randomSpot(tiles);
+            if (i % 2) {
+                const wall & w = tiles.walls[rng::random(tiles.walls.size())];
+                probe.x = tiles.posX + w.getPosX() - 32 + rng::random<64>();
+                probe.y = tiles.posY + w.getPosY() - 40 + rng::random<48>();
+            }
+            const float dir = rng::random<6283>() / 1000.f;
+            probes.push_back(probe);
+            ends.push_back({probe.x + std::cos(dir) * 90,
+                            probe.y + std::sin(dir) * 90});
+        }
+        for (unsigned i = 0; i < probeCount; ++i) {
+            const sf::Vector2f & a = probes[i], & b = ends[i];
+            if (scanWallCollision(tiles, a.x, a.y) !=
+                    wallCollisionMask(tiles, a.x, a.y) ||
+                scanWallAlongSegment(tiles, a.x, a.y, b.x, b.y) !=
+                    wallAlongSegment(tiles, a.x, a.y, b.x, b.y)) {
+                agreed = false;
+            }
+        }
+        const auto timeAll = [&](auto query) {
+            return timeRounds(rounds, [&] {
+                       uint64_t hits = 0;
+                       for (unsigned i = 0; i < probeCount; ++i) {
+                           hits += query(probes[i], ends[i]);
+                       }
+                       return hits;
+                   }) /
+                   probeCount;
+        };
+        std::cout << std::setw(6) << level << std::setw(7)
+                  << tiles.walls.size() << std::setw(8) << "mask";
+        printSpeedup(timeAll([&](const sf::Vector2f & a, const sf::Vector2f &) {
+                         return scanWallCollision(tiles, a.x, a.y);
+                     }),
+                     timeAll([&](const sf::Vector2f & a, const sf::Vector2f &) {
+                         return wallCollisionMask(tiles, a.x, a.y);
+                     }));
+        std::cout << std::setw(21) << "ray";
+        printSpeedup(
+            timeAll([&](const sf::Vector2f & a, const sf::Vector2f & b) {
+                return scanWallAlongSegment(tiles, a.x, a.y, b.x, b.y);
+            }),
+            timeAll([&](const sf::Vector2f & a, const sf::Vector2f & b) {
+                return wallAlongSegment(tiles, a.x, a.y, b.x, b.y);
+            }));
+    }
+    if (!agreed) {
+        std::cerr << "walls: the grid and the scan disagree" << std::endl;
+    }
+    return agreed;
+}
+
+// Players against enemies and enemies against shots, spread over a whole
+// level at growing densities, testing every pair against filing everything
+// in a SpatialHash, rebuild included. Where the two cross over is where
+// CollisionIndex starts hashing a kind instead of going through it.
+static bool benchHits(unsigned rounds) {
+    using PlayerBox = HitBox<8, 16, 12, 12>;
+    using EnemyBox = HitBox<20, 32, -6, -4>;
+    using ShotBox = HitBox<12, 12, 2, 2>;
+    enum { Enemy, Shot };
+    static const unsigned playerCount = 4;
+    SpatialHash hash(32.f, 1024);
+    bool agreed = true;
+    std::cout << "hits: ns per hit box query" << std::endl;
+    std::cout << std::setw(8) << "enemies" << std::setw(7) << "shots"
+              << std::setw(10) << "pairwise" << std::setw(10) << "hashed"
+              << std::setw(9) << "speedup" << std::endl;
+    for (size_t count : {16, 64, 256, 1024}) {
+        std::vector<PlayerBox> players(playerCount);
+        std::vector<EnemyBox> enemies(count);
+        std::vector<ShotBox> shots(count);
+        const auto place = [](auto & boxes) {
+            for (auto & box : boxes) {
+                box.setPosition(
+                    rng::random(61 * 32) + rng::random<100>() / 100.f,
+                    rng::random(61 * 26) + rng::random<100>() / 100.f);
+            }
+        };
+        place(players);
+        place(enemies);
+        place(shots);
+        // Every hit as (querying index, hit index), in the order the game
+        // would see them
+        std::vector<std::pair<size_t, size_t>> pairwiseHits, hashedHits;
+        const auto pairwise = [&] {
+            pairwiseHits.clear();
+            for (size_t i = 0; i < players.size(); ++i) {
+                for (size_t j = 0; j < enemies.size(); ++j) {
+                    if (players[i].overlapping(enemies[j])) {
+                        pairwiseHits.emplace_back(i, j);
+                    }
+                }
+            }
+            for (size_t i = 0; i < enemies.size(); ++i) {
+                for (size_t j = 0; j < shots.size(); ++j) {
+                    if (enemies[i].overlapping(shots[j])) {
+                        pairwiseHits.emplace_back(i, j);
+                    }
+                }
+            }
+            return pairwiseHits.size();
+        };
+        const auto hashed = [&] {
+            hashedHits.clear();
+            hash.clear();
+            for (auto & enemy : enemies) {
+                hash.insert(Enemy, enemy.getXPos(), enemy.getYPos(),
+                            enemy.getWidth(), enemy.getHeight(), &enemy);
+            }
+            for (auto & shot : shots) {
+                hash.insert(Shot, shot.getXPos(), shot.getYPos(),
+                            shot.getWidth(), shot.getHeight(), &shot);
+            }
+            hash.build();
+            const auto query = [&](uint32_t kind, size_t i, const auto & box,
+                                   const auto * first) {
+                hash.query(kind, box.getXPos(), box.getYPos(), box.getWidth(),
+                           box.getHeight(),
+                           [&](const SpatialHash::Entry & entry) {
+                               hashedHits.emplace_back(
+                                   i, static_cast<decltype(first)>(
+                                          entry.object) -
+                                          first);
+                           });
+            };
+            for (size_t i = 0; i < players.size(); ++i) {
+                query(Enemy, i, players[i], enemies.data());
+            }
+            for (size_t i = 0; i < enemies.size(); ++i) {
+                query(Shot, i, enemies[i], shots.data());
+            }
+            return hashedHits.size();
+        };
+        pairwise();
+        hashed();
+        agreed = agreed && pairwiseHits == hashedHits;
+        // The pairwise side grows with the square of the count
+        const unsigned scaled = std::max(rounds * 16 / unsigned(count), 1u);
+        const double queries = double(playerCount + count);
+        std::cout << std::setw(8) << count << std::setw(7) << count;
+        printSpeedup(timeRounds(scaled, pairwise) / queries,
+                     timeRounds(scaled, hashed) / queries);
+    }
+    if (!agreed) {
+        std::cerr << "hits: the hash and the pairwise tests disagree"
+                  << std::endl;
+    }
+    return agreed;
+}
+
+// Enemies spread over a whole level at growing densities, culled against a
+// screen sized view by testing each one like enemyController used to against
+// asking a ViewCuller. The culler is on every enemy's path each tick, so it
+// fails if it's much slower than the test it replaced, not just if it
+// disagrees.
+static bool benchCull(unsigned rounds) {
+    static const sf::Texture texture;
+    static const float margin = 32.f;
+    tileController tiles;
+    enemyController enemies;
+    ViewCuller culler;
+    std::vector<const Critter *> tested, culled;
+    bool agreed = true, keptUp = true;
+    loadLevel(tiles);
+    std::cout << "cull: ns per enemy per frame" << std::endl;
+    std::cout << std::setw(8) << "enemies" << std::setw(9) << "visible"
+              << std::setw(10) << "tested" << std::setw(10) << "culled"
+              << std::setw(9) << "speedup" << std::endl;
+    for (size_t count : {64, 256, 1024, 4096}) {
+        auto & critters = enemies.getCritters();
+        critters.clear();
+        for (size_t i = 0; i < count; ++i) {
+            const sf::Vector2f spot = randomSpot(tiles);
+            critters.push_back(
+                std::make_shared<Critter>(texture, spot.x, spot.y));
+        }
+        const sf::Vector2f center = randomSpot(tiles);
+        const sf::View view(center, {480.f, 270.f});
+        const auto test = [&] {
+            tested.clear();
+            const sf::Vector2f viewCenter = view.getCenter();
+            const sf::Vector2f viewSize = view.getSize();
+            for (auto & critter : critters) {
+                const sf::Vector2f & pos = critter->getPosition();
+                if (pos.x > viewCenter.x - viewSize.x / 2 - margin &&
+                    pos.x < viewCenter.x + viewSize.x / 2 + margin &&
+                    pos.y > viewCenter.y - viewSize.y / 2 - margin &&
+                    pos.y < viewCenter.y + viewSize.y / 2 + margin) {
+                    tested.push_back(critter.get());
+                }
+            }
+            return tested.size();
+        };
+        const auto cull = [&] {
+            culled.clear();
+            culler.setView(view);
+            culler.forEachVisible(critters, margin,
+                                  [&](const std::shared_ptr<Critter> & c) {
+                                      culled.push_back(c.get());
+                                  });
+            return culled.size();
+        };
+        test();
+        cull();
+        agreed = agreed && tested == culled;
+        const double testTime = timeRounds(rounds, test) / count;
+        const double cullTime = timeRounds(rounds, cull) / count;
+        // Plenty of room for timing noise
+        keptUp = keptUp && cullTime < testTime * 2;
+        std::cout << std::setw(8) << count << std::setw(9) << tested.size();
+        printSpeedup(testTime, cullTime);
+    }
+    if (!agreed) {
+        std::cerr << "cull: the culler and the view test disagree"
+                  << std::endl;
+    }
+    if (!keptUp) {
+        std::cerr << "cull: the culler is over twice as slow as the view test"
+                  << std::endl;
+    }
+    return agreed && keptUp;
+}
+
+// Searches between random walkable tiles on generated levels, plain A* on
+// the eight way grid against Jump Point Search on the same grid, with how
+// many tiles each expanded per search. Both have to find paths of the same
+// cost.
+static bool benchPaths(unsigned rounds) {
+    static const unsigned levels = 3, pairCount = 64;
+    tileController tiles;
+    std::vector<aStrCoordinate> walkable, origins, targets, path;
+    bool agreed = true;
+    std::cout << "paths: tiles expanded and ns per search" << std::endl;
+    std::cout << std::setw(6) << "level" << std::setw(9) << "walkable"
+              << std::setw(9) << "A* exp" << std::setw(9) << "JPS exp"
+              << std::setw(10) << "A*" << std::setw(10) << "JPS"
+              << std::setw(9) << "speedup" << std::endl;
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        walkable.clear();
+        tiles.layers.forEach(MapLayers::Walkable, 0, MAP_WIDTH - 1, 0,
+                             MAP_HEIGHT - 1, [&](int x, int y) {
+                                 walkable.push_back({x, y, 0.f, 0.f});
+                                 return false;
+                             });
+        origins.clear();
+        targets.clear();
+        for (unsigned i = 0; i < pairCount; ++i) {
+            origins.push_back(walkable[rng::random(walkable.size())]);
+            targets.push_back(walkable[rng::random(walkable.size())]);
+        }
+        uint64_t expanded[2] = {};
+        for (unsigned i = 0; i < pairCount; ++i) {
+            int count;
+            const bool reached = astar_octile_path(origins[i], targets[i],
+                                                   tiles.layers, path, &count);
+            const float cost = path.back().g;
+            expanded[0] += count;
+            agreed = agreed &&
+                     jps_path(origins[i], targets[i], tiles.layers, path,
+                              &count) == reached &&
+                     (!reached || std::abs(path.back().g - cost) < 1e-3f);
+            expanded[1] += count;
+        }
+        const auto timeAll = [&](auto search) {
+            // A search takes microseconds rather than nanoseconds
+            return timeRounds(std::max(rounds / 16, 1u), [&] {
+                       uint64_t steps = 0;
+                       for (unsigned i = 0; i < pairCount; ++i) {
+                           search(origins[i], targets[i], tiles.layers, path,
+                                  nullptr);
+                           steps += path.size();
+                       }
+                       return steps;
+                   }) /
+                   pairCount;
+        };
+        std::cout << std::setw(6) << level << std::setw(9) << walkable.size()
+                  << std::setw(9) << expanded[0] / pairCount << std::setw(9)
+                  << expanded[1] / pairCount;
+        printSpeedup(timeAll(astar_octile_path), timeAll(jps_path));
+    }
+    if (!agreed) {
+        std::cerr << "paths: jump points and A* found different costs"
+                  << std::endl;
+    }
+    return agreed;
+}
+
+int runBenchmark(const BenchOptions & options) {
+    static const std::map<std::string, std::function<bool(unsigned)>>
+        benchmarks = {{"cull", benchCull},
+                      {"hits", benchHits},
+                      {"overlap", benchOverlap},
+                      {"paths", benchPaths},
+                      {"walls", benchWalls}};
+    auto found = benchmarks.find(options.name);
+    if (found == benchmarks.end()) {
+        std::cerr << "unknown benchmark " << options.name << ", try one of:";
+        for (auto & benchmark : benchmarks) {
+            std::cerr << ' ' << benchmark.first;
+        }
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+    }
+    return found->second(std::max(options.rounds, 1u)) ? EXIT_SUCCESS
+                                                        : EXIT_FAILURE;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+//
+// Micro-benchmarks for the hot paths, timing the fast version against the
+// straightforward one on made up but game sized inputs, and failing if the
+// two ever give different answers. Started from the command line with
+// --bench <name> [rounds], they print a table and, like --check, only need
+// the headless resources.
+//
+struct BenchOptions {
+    std::string name;
+    // How many times to repeat each measurement, more gives steadier numbers
+    unsigned rounds = 2000;
+};
+
+int runBenchmark(const BenchOptions & options);
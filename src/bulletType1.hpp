@@ -11,11 +11,14 @@ class _PlayerShot : public Drawable<_PlayerShot<DrawPolicy>, DrawPolicy>,
                     public Effect {
 public:
     static const int drawOffset = 0;
-    using HBox = HitBox<12, 12, 2, 2>;
+    // Shots cover a lot of ground in a tick, the hit box takes in all of
+    // it so that they can't skip over an enemy
+    using HBox = SweptHitBox<12, 12, 2, 2>;
     _PlayerShot(const sf::Texture & mainTxtr, const sf::Texture & glowTxtr,
                 char dir, float x, float y)
         : Effect{x, y}, xInit{x}, yInit{y}, direction{dir}, canPoof{true},
           state{State::travelling} {
+        hitBox.setPosition(x, y);
         spriteSheet.setTexture(mainTxtr);
         puffSheet.setTexture(mainTxtr);
         glow.setTexture(glowTxtr);
@@ -49,7 +52,7 @@ public:
     template <typename Game> void update(const sf::Time & elapsedTime, Game *) {
         const static float movementRate = 0.00038f;
         timer += elapsedTime.asMilliseconds();
-        hitBox.setPosition(position);
+        hitBox.sweepTo(position);
         switch (state) {
         case State::travelling:
             if (direction == 0 || direction == 4) {
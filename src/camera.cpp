@@ -7,7 +7,9 @@ Camera::Camera(Player * _pTarget, const sf::Vector2f & viewPort,
       overworldView(sf::Vector2f(viewPort.x / 2, viewPort.y / 2), viewPort),
       startPosition(overworldView.getCenter()), currentPosition(startPosition),
       windowSize(_windowSize), isShaking(false), shakeIndex(0), shakeTimer(0),
-      trackingTimer(0), shakeIntensity(0.f), state(State::followPlayer) {}
+      trackingTimer(0), shakeIntensity(0.f), state(State::followPlayer) {
+    savePosition();
+}
 
 void Camera::update(const sf::Time & elapsedTime,
                     const std::vector<sf::Vector2f> & targets) {
@@ -113,18 +115,38 @@ const sf::View & Camera::getOverworldView() const { return overworldView; }
 
 const sf::View & Camera::getWindowView() const { return windowView; }
 
+// The views as they were at the start of the current logic tick
+sf::View Camera::getPrevOverworldView() const {
+    sf::View view(overworldView);
+    view.setCenter(previousOverworldCenter);
+    return view;
+}
+
+sf::View Camera::getPrevWindowView() const {
+    sf::View view(windowView);
+    view.setCenter(previousWindowCenter);
+    return view;
+}
+
+void Camera::savePosition() {
+    previousOverworldCenter = overworldView.getCenter();
+    previousWindowCenter = windowView.getCenter();
+}
+
 void Camera::panDown() {
     float placementOffset = pTarget->getPosition().y / 2;
     overworldView.setCenter(
         sf::Vector2f(pTarget->getPosition().x, placementOffset));
     startPosition = overworldView.getCenter();
     currentPosition = startPosition;
+    savePosition();
 }
 
 void Camera::snapToTarget() {
     overworldView.setCenter(pTarget->getPosition());
     startPosition = overworldView.getCenter();
     currentPosition = startPosition;
+    savePosition();
 }
 
 void Camera::setOverworldView(const sf::View & _overworldView) {
@@ -133,6 +155,7 @@ void Camera::setOverworldView(const sf::View & _overworldView) {
 
 void Camera::setWindowView(const sf::View & _windowView) {
     windowView = _windowView;
+    savePosition();
 }
 
 bool Camera::moving() const {
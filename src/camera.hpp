@@ -11,6 +11,7 @@ class Camera {
     Player * pTarget;
     sf::View overworldView, windowView;
     sf::Vector2f startPosition, midpoint, buffer, currentPosition;
+    sf::Vector2f previousOverworldCenter, previousWindowCenter;
     sf::Vector2u windowSize;
     bool isShaking;
     uint8_t shakeIndex;
@@ -28,6 +29,9 @@ public:
     void panDown();
     const sf::View & getOverworldView() const;
     const sf::View & getWindowView() const;
+    sf::View getPrevOverworldView() const;
+    sf::View getPrevWindowView() const;
+    void savePosition();
     void shake(float);
     void setOverworldView(const sf::View &);
     void setWindowView(const sf::View &);
@@ -0,0 +1,636 @@
+#include "checks.hpp"
+#include "aStar.hpp"
+#include "framework/framework.hpp"
+#include "framework/spatialHash.hpp"
+#include "inputController.hpp"
+#include "jumpPoints.hpp"
+#include "levelBlueprint.hpp"
+#include "rng.hpp"
+#include "tileController.hpp"
+#include "wallCollision.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <queue>
+#include <vector>
+
+// Generates a level into tiles and places its walls the way a game would
+static void loadLevel(tileController & tiles) {
+    tiles.clear();
+    tiles.rebuild(std::move(*buildLevel(false)));
+    // Like Game::nextLevel(), plus a fraction so that the walls don't always
+    // land on whole pixels
+    tiles.setPosition(400 + rng::random<100>() / 100.f,
+                      234 + rng::random<100>() / 100.f);
+}
+
+static bool checkCollision(unsigned levels) {
+    tileController tiles;
+    uint64_t probes = 0, mismatches = 0;
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        auto probe = [&](float x, float y) {
+            const uint_fast8_t expected = scanWallCollision(tiles, x, y);
+            const uint_fast8_t actual = wallCollisionMask(tiles, x, y);
+            ++probes;
+            if (expected != actual) {
+                if (++mismatches <= 10) {
+                    std::cerr << "collision: at (" << x << ", " << y
+                              << ") expected " << int(expected) << ", got "
+                              << int(actual) << std::endl;
+                }
+            }
+        };
+        // Anywhere on (and a bit beyond) the map
+        for (int i = 0; i < 20000; ++i) {
+            probe(tiles.posX - 64 + rng::random(61 * 32 + 128) +
+                      rng::random<1000>() / 1000.f,
+                  tiles.posY - 64 + rng::random(61 * 26 + 128) +
+                      rng::random<1000>() / 1000.f);
+        }
+        // Right on the edges of the probe's comparisons, where rounding
+        // would show up
+        for (auto & w : tiles.walls) {
+            for (float dx : {-26.f, -16.f, -8.f, 6.f, 16.f, 24.f}) {
+                for (float dy : {-29.f, -22.f, -10.f, -3.f, 4.f, 36.f}) {
+                    probe(tiles.posX + w.getPosX() + dx,
+                          tiles.posY + w.getPosY() + dy);
+                }
+            }
+        }
+    }
+    std::cout << "collision: " << probes << " probes on " << levels
+              << " levels, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+// Casts rays of the length enemies look ahead over generated levels, and
+// checks the grid walk and the gathered footprints against testing every
+// wall. The old six point sampling must never see a wall the cast misses.
+static bool checkRaycast(unsigned levels) {
+    tileController tiles;
+    std::vector<WallFootprint> footprints;
+    uint64_t rays = 0, mismatches = 0;
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        for (int i = 0; i < 5000; ++i) {
+            const float x = tiles.posX + rng::random(61 * 32) +
+                            rng::random<1000>() / 1000.f;
+            const float y = tiles.posY + rng::random(61 * 26) +
+                            rng::random<1000>() / 1000.f;
+            gatherWallFootprints(tiles, x, y, 90, footprints);
+            for (int k = 0; k < 8; ++k) {
+                const float dir = rng::random<6283>() / 1000.f;
+                const float dx = std::cos(dir), dy = std::sin(dir);
+                const float x0 = x + dx * 10, y0 = y + dy * 10;
+                const float x1 = x + dx * 90, y1 = y + dy * 90;
+                // The footprints are tile-local, offset the same way the
+                // queries do
+                const float localX0 = x0 - tiles.posX;
+                const float localY0 = y0 - tiles.posY;
+                const float localX1 = localX0 + (x1 - x0);
+                const float localY1 = localY0 + (y1 - y0);
+                const bool expected =
+                    scanWallAlongSegment(tiles, x0, y0, x1, y1);
+                bool sampled = false;
+                for (int d = 10; d < 100; d += 16) {
+                    sampled = sampled ||
+                              scanWallCollision(tiles, x + dx * d,
+                                                y + dy * d) != 0;
+                }
+                ++rays;
+                if (expected != wallAlongSegment(tiles, x0, y0, x1, y1) ||
+                    expected !=
+                        footprintsAlongSegment(footprints, localX0, localY0,
+                                               localX1, localY1) ||
+                    (sampled && !expected)) {
+                    if (++mismatches <= 10) {
+                        std::cerr << "raycast: from (" << x << ", " << y
+                                  << ") towards " << dir << " disagrees"
+                                  << std::endl;
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "raycast: " << rays << " rays on " << levels << " levels, "
+              << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+// Sweeps the wall probe and a hit box along random short moves, and checks
+// both against stepping along the move a tenth of a pixel or so at a time
+static bool checkSweep(unsigned levels) {
+    static const int steps = 500;
+    tileController tiles;
+    uint64_t sweeps = 0, mismatches = 0;
+    auto report = [&mismatches](const char * what, float x0, float y0,
+                                float x1, float y1) {
+        if (++mismatches <= 10) {
+            std::cerr << "sweep: " << what << " from (" << x0 << ", " << y0
+                      << ") to (" << x1 << ", " << y1 << ") disagrees"
+                      << std::endl;
+        }
+    };
+    auto randomMove = [](float & x1, float & y1, float x0, float y0) {
+        const float dir = rng::random<6283>() / 1000.f;
+        const float length =
+            1 + rng::random<64>() + rng::random<1000>() / 1000.f;
+        x1 = x0 + std::cos(dir) * length;
+        y1 = y0 + std::sin(dir) * length;
+    };
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        for (int i = 0; i < 2000; ++i) {
+            const float x0 = tiles.posX + rng::random(61 * 32) +
+                             rng::random<1000>() / 1000.f;
+            const float y0 = tiles.posY + rng::random(61 * 26) +
+                             rng::random<1000>() / 1000.f;
+            // Only moves that start clear, a probe already touching a wall
+            // is allowed to carry on
+            if (scanWallCollision(tiles, x0, y0)) {
+                continue;
+            }
+            float x1, y1;
+            randomMove(x1, y1, x0, y0);
+            const float t = wallSweep(tiles, x0, y0, x1, y1);
+            int firstHit = steps + 1;
+            for (int k = 1; k <= steps; ++k) {
+                const float s = float(k) / steps;
+                if (scanWallCollision(tiles, x0 + (x1 - x0) * s,
+                                      y0 + (y1 - y0) * s)) {
+                    firstHit = k;
+                    break;
+                }
+            }
+            ++sweeps;
+            // Stepping can find the wall up to a step late, or step right
+            // over a corner the probe only clips; in that case there has
+            // to be a wall within a hair of where the sweep stopped
+            const float found = float(firstHit) / steps;
+            if (t < 1.f && found > t + 2.f / steps) {
+                const float x = x0 + (x1 - x0) * t, y = y0 + (y1 - y0) * t;
+                bool grazed = false;
+                for (float nudgeX : {-0.1f, 0.f, 0.1f}) {
+                    for (float nudgeY : {-0.1f, 0.f, 0.1f}) {
+                        grazed = grazed || wallCollisionMask(tiles, x + nudgeX,
+                                                             y + nudgeY);
+                    }
+                }
+                if (!grazed) {
+                    report("wall", x0, y0, x1, y1);
+                }
+            } else if (t > found + 1e-4f) {
+                report("wall", x0, y0, x1, y1);
+            }
+        }
+    }
+    for (unsigned i = 0; i < levels * 10000; ++i) {
+        const float x0 = rng::random<200>() + rng::random<1000>() / 1000.f;
+        const float y0 = rng::random<200>() + rng::random<1000>() / 1000.f;
+        float x1, y1;
+        randomMove(x1, y1, x0, y0);
+        HitBox<12, 12, 2, 2> other;
+        other.setPosition(
+            60 + rng::random<80>() + rng::random<1000>() / 1000.f,
+            60 + rng::random<80>() + rng::random<1000>() / 1000.f);
+        SweptHitBox<20, 32, -6, -4> swept;
+        swept.setPosition(x0, y0);
+        swept.sweepTo(x1, y1);
+        // Whether a HitBox<20, 32, -6, -4> stepped along the move overlaps
+        // other grown by slack on each side
+        auto stepped = [&](float slack) {
+            for (int k = 0; k <= steps; ++k) {
+                const float s = float(k) / steps;
+                const float x = x0 + (x1 - x0) * s - 6;
+                const float y = y0 + (y1 - y0) * s - 4;
+                if (x < other.getXPos() + 12 + slack &&
+                    x + 20 > other.getXPos() - slack &&
+                    y < other.getYPos() + 12 + slack &&
+                    y + 32 > other.getYPos() - slack) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        ++sweeps;
+        // Stepping can step over a corner that the box only clips, so the
+        // sweep may find a hit the steps miss, but only by a hair
+        const bool actual = swept.overlapping(other);
+        if (actual != stepped(0.f) && !(actual && stepped(0.05f))) {
+            report("hit box", x0, y0, x1, y1);
+        }
+    }
+    std::cout << "sweep: " << sweeps << " sweeps on " << levels
+              << " levels, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+// Fills a SpatialHash with boxes spread over a map's worth of space, then
+// checks its queries against testing every box, order included
+static bool checkSpatialHash(unsigned levels) {
+    struct Box {
+        float x, y, w, h;
+        uint32_t kind;
+    };
+    SpatialHash hash(32.f, 1024);
+    std::vector<Box> boxes;
+    std::vector<const Box *> expected, actual;
+    uint64_t queries = 0, mismatches = 0;
+    auto randomCoord = [](int range) {
+        return -64 + rng::random(range + 128) + rng::random<1000>() / 1000.f;
+    };
+    for (unsigned level = 0; level < levels; ++level) {
+        boxes.clear();
+        const size_t count = 50 + rng::random<500>();
+        for (size_t i = 0; i < count; ++i) {
+            boxes.push_back({randomCoord(61 * 32), randomCoord(61 * 26),
+                             float(4 + rng::random<29>()),
+                             float(4 + rng::random<29>()),
+                             uint32_t(rng::random<4>())});
+        }
+        hash.clear();
+        for (auto & box : boxes) {
+            hash.insert(box.kind, box.x, box.y, box.w, box.h, &box);
+        }
+        hash.build();
+        for (int i = 0; i < 2000; ++i) {
+            const Box query{randomCoord(61 * 32), randomCoord(61 * 26),
+                            float(4 + rng::random<29>()),
+                            float(4 + rng::random<29>()),
+                            uint32_t(rng::random<4>())};
+            expected.clear();
+            for (auto & box : boxes) {
+                if (box.kind == query.kind && query.x < box.x + box.w &&
+                    query.x + query.w > box.x && query.y < box.y + box.h &&
+                    query.y + query.h > box.y) {
+                    expected.push_back(&box);
+                }
+            }
+            actual.clear();
+            hash.query(query.kind, query.x, query.y, query.w, query.h,
+                       [&actual](const SpatialHash::Entry & entry) {
+                           actual.push_back(
+                               static_cast<const Box *>(entry.object));
+                       });
+            ++queries;
+            if (expected != actual && ++mismatches <= 10) {
+                std::cerr << "spatial: query at (" << query.x << ", "
+                          << query.y << ") expected " << expected.size()
+                          << " boxes, got " << actual.size() << std::endl;
+            }
+        }
+    }
+    std::cout << "spatial: " << queries << " queries on " << levels
+              << " layouts, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+static void findWalkable(const tileController & tiles,
+                         std::vector<aStrCoordinate> & walkable) {
+    walkable.clear();
+    for (int x = 0; x < MAP_WIDTH; ++x) {
+        for (int y = 0; y < MAP_HEIGHT; ++y) {
+            if (tiles.layers.test(MapLayers::Walkable, x, y)) {
+                walkable.push_back({x, y, 0.f, 0.f});
+            }
+        }
+    }
+}
+
+// Searches between random walkable tiles, checking each path step by step
+// and its cost against a plain Dijkstra over getAdjacent(), which finds the
+// cheapest cost from the origin to every tile. The paths traced back through
+// a FlowField out of the origin get the same treatment. Searches go through a
+// PathCache that is never cleared, and keep going back to the same few
+// targets, so cached paths have to be right too and never outlive their map.
+static bool checkPaths(unsigned levels) {
+    using Node = std::pair<float, int>;
+    static const float unreached = std::numeric_limits<float>::infinity();
+    tileController tiles;
+    FlowField field;
+    PathCache cache;
+    std::vector<aStrCoordinate> walkable, targets, path;
+    std::vector<float> cost(MAP_WIDTH * MAP_HEIGHT);
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+    uint64_t paths = 0, mismatches = 0;
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        findWalkable(tiles, walkable);
+        for (int i = 0; i < 20; ++i) {
+            aStrCoordinate origin = walkable[rng::random(walkable.size())];
+            std::fill(cost.begin(), cost.end(), unreached);
+            cost[origin.x * MAP_HEIGHT + origin.y] = 0.f;
+            open.push({0.f, origin.x * MAP_HEIGHT + origin.y});
+            while (!open.empty()) {
+                const Node node = open.top();
+                open.pop();
+                if (node.first > cost[node.second]) {
+                    continue;
+                }
+                aStrCoordinate coord{node.second / MAP_HEIGHT,
+                                     node.second % MAP_HEIGHT, 0.f,
+                                     node.first};
+                for (auto & next : getAdjacent(coord, coord, tiles.layers)) {
+                    float & nextCost = cost[next.x * MAP_HEIGHT + next.y];
+                    if (next.g < nextCost) {
+                        nextCost = next.g;
+                        open.push({next.g, next.x * MAP_HEIGHT + next.y});
+                    }
+                }
+            }
+            field.reset();
+            field.update(origin.x, origin.y, tiles.layers);
+            targets.clear();
+            for (int j = 0; j < 10; ++j) {
+                targets.push_back(walkable[rng::random(walkable.size())]);
+            }
+            for (int j = 0; j < 100; ++j) {
+                const aStrCoordinate & target =
+                    j % 2 ? walkable[rng::random(walkable.size())]
+                          : targets[rng::random(targets.size())];
+                const float expected = cost[target.x * MAP_HEIGHT + target.y];
+                // Half the time from the field, which leaves the path empty
+                // where A* would find its way to the nearest tile
+                const bool traced = j % 2;
+                const bool reached =
+                    traced ? field.trace(target.x, target.y, path)
+                           : cache.find(origin, target, tiles.layers, path);
+                // Every step has to be one getAdjacent() allows, at the
+                // cost it says
+                bool valid = path.empty()
+                                 ? traced && !reached
+                                 : path.front().x == origin.x &&
+                                       path.front().y == origin.y;
+                float total = 0.f;
+                for (size_t k = 1; valid && k < path.size(); ++k) {
+                    aStrCoordinate from = path[k - 1];
+                    from.g = total;
+                    valid = false;
+                    for (auto & step : getAdjacent(from, from, tiles.layers)) {
+                        if (step.x == path[k].x && step.y == path[k].y) {
+                            total = step.g;
+                            valid = true;
+                        }
+                    }
+                }
+                ++paths;
+                if (reached) {
+                    valid = valid && path.back().x == target.x &&
+                            path.back().y == target.y &&
+                            total == expected && path.back().g == expected;
+                } else {
+                    valid = valid && expected == unreached;
+                }
+                if (!valid && ++mismatches <= 10) {
+                    std::cerr << "paths: " << (traced ? "traced" : "searched")
+                              << " from (" << origin.x << ", "
+                              << origin.y << ") to (" << target.x << ", "
+                              << target.y << ") expected a cost of "
+                              << expected << ", got " << total << " over "
+                              << path.size() << " tiles" << std::endl;
+                }
+            }
+        }
+    }
+    std::cout << "paths: " << paths << " paths on " << levels << " levels, "
+              << cache.getHits() << " from the cache, " << mismatches
+              << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+// Asks a PathQueue for paths between random walkable tiles, then services
+// it a small random budget at a time so that most searches get split over
+// several calls, cancelling the odd request along the way. Every path has to
+// come out the same as searching in one go.
+static bool checkPathQueue(unsigned levels) {
+    struct Request {
+        PathQueue::Handle handle;
+        aStrCoordinate origin, target;
+    };
+    tileController tiles;
+    PathQueue queue;
+    PathCache cache;
+    std::vector<aStrCoordinate> walkable, expected, actual;
+    std::vector<Request> requests;
+    uint64_t paths = 0, cancelled = 0, mismatches = 0;
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        findWalkable(tiles, walkable);
+        queue.clear();
+        requests.clear();
+        for (int i = 0; i < 50; ++i) {
+            const aStrCoordinate & origin =
+                walkable[rng::random(walkable.size())];
+            const aStrCoordinate & target =
+                walkable[rng::random(walkable.size())];
+            requests.push_back({queue.submit(origin, target), origin, target});
+        }
+        // Plenty for every search to finish, unless one gets stuck
+        for (int round = 0; round < 100000 && !requests.empty(); ++round) {
+            queue.service(tiles.layers, cache, 1 + rng::random<400>());
+            if (rng::random<20>() == 0) {
+                queue.cancel(requests.front().handle);
+                requests.erase(requests.begin());
+                ++cancelled;
+            }
+            for (auto it = requests.begin(); it != requests.end();) {
+                if (!queue.take(it->handle, actual)) {
+                    ++it;
+                    continue;
+                }
+                astar_path(it->origin, it->target, tiles.layers, expected);
+                ++paths;
+                const bool same =
+                    expected.size() == actual.size() &&
+                    std::equal(expected.begin(), expected.end(),
+                               actual.begin(),
+                               [](const aStrCoordinate & a,
+                                  const aStrCoordinate & b) {
+                                   return a.x == b.x && a.y == b.y &&
+                                          a.g == b.g;
+                               });
+                if (!same && ++mismatches <= 10) {
+                    std::cerr << "queue: from (" << it->origin.x << ", "
+                              << it->origin.y << ") to (" << it->target.x
+                              << ", " << it->target.y << ") expected "
+                              << expected.size() << " tiles, got "
+                              << actual.size() << std::endl;
+                }
+                it = requests.erase(it);
+            }
+        }
+        if (!requests.empty()) {
+            std::cerr << "queue: " << requests.size()
+                      << " requests never finished" << std::endl;
+            mismatches += requests.size();
+        }
+    }
+    std::cout << "queue: " << paths << " paths and " << cancelled
+              << " cancelled on " << levels << " levels, " << mismatches
+              << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+// Searches between random walkable tiles with Jump Point Search and with
+// plain A* on the same eight way grid. Both have to take only legal steps,
+// diagonals squeezing between two open tiles, and come out equally cheap.
+static bool checkJumpPoints(unsigned levels) {
+    tileController tiles;
+    std::vector<aStrCoordinate> walkable, paths[2];
+    uint64_t searches = 0, mismatches = 0, expanded[2] = {};
+    const auto open = [&](int x, int y) {
+        return x >= 0 && x < MAP_WIDTH && y >= 0 && y < MAP_HEIGHT &&
+               tiles.layers.test(MapLayers::Walkable, x, y);
+    };
+    for (unsigned level = 0; level < levels; ++level) {
+        loadLevel(tiles);
+        findWalkable(tiles, walkable);
+        for (int i = 0; i < 500; ++i) {
+            const aStrCoordinate & origin =
+                walkable[rng::random(walkable.size())];
+            const aStrCoordinate & target =
+                walkable[rng::random(walkable.size())];
+            int count[2];
+            const bool reached[2] = {
+                astar_octile_path(origin, target, tiles.layers, paths[0],
+                                  &count[0]),
+                jps_path(origin, target, tiles.layers, paths[1], &count[1])};
+            float totals[2] = {};
+            bool valid = reached[0] == reached[1];
+            for (int k = 0; k < 2; ++k) {
+                const auto & path = paths[k];
+                expanded[k] += count[k];
+                valid = valid && !path.empty() && path.front().x == origin.x &&
+                        path.front().y == origin.y;
+                for (size_t step = 1; valid && step < path.size(); ++step) {
+                    const int x = path[step - 1].x, y = path[step - 1].y;
+                    const int xOff = path[step].x - x;
+                    const int yOff = path[step].y - y;
+                    valid = std::abs(xOff) <= 1 && std::abs(yOff) <= 1 &&
+                            (xOff || yOff) && open(x + xOff, y + yOff) &&
+                            (!xOff || !yOff ||
+                             (open(x + xOff, y) && open(x, y + yOff)));
+                    totals[k] += xOff && yOff ? std::sqrt(2.f) : 1.f;
+                }
+                valid = valid && std::abs(path.back().g - totals[k]) < 1e-3f;
+                if (reached[k]) {
+                    valid = valid && path.back().x == target.x &&
+                            path.back().y == target.y;
+                }
+            }
+            valid = valid && (!reached[0] ||
+                              std::abs(totals[0] - totals[1]) < 1e-3f);
+            ++searches;
+            if (!valid && ++mismatches <= 10) {
+                std::cerr << "jps: from (" << origin.x << ", " << origin.y
+                          << ") to (" << target.x << ", " << target.y
+                          << ") A* cost " << totals[0] << " over "
+                          << paths[0].size() << " tiles, jump points cost "
+                          << totals[1] << " over " << paths[1].size()
+                          << " tiles" << std::endl;
+            }
+        }
+    }
+    std::cout << "jps: " << searches << " searches on " << levels
+              << " levels, " << expanded[0] << " tiles expanded by A* and "
+              << expanded[1] << " by jump points, " << mismatches
+              << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+// Taps the shoot key between ticks, some of them during a run of ticks
+// frozen by a hit stop, where nothing reads the buttons and the edges are
+// left alone. Each tap has to show up on the first tick that does read them,
+// once, and a key pressed after a tick was due has to wait for the next one.
+static bool checkInput(unsigned levels) {
+    nlohmann::json config = {
+        {"Keyboard",
+         {{"Up", "up"},
+          {"Down", "down"},
+          {"Left", "left"},
+          {"Right", "right"},
+          {"Shoot", "x"},
+          {"Action", "z"},
+          {"Pause", "esc"}}},
+        {"Joystick", nlohmann::json::object()}};
+    InputController input(config);
+    const auto send = [&input](sf::Event::EventType type) {
+        sf::Event event;
+        event.type = type;
+        event.key.code = sf::Keyboard::X;
+        input.recordEvent(event);
+    };
+    const auto tapped = [&input] {
+        return input.shootPressed() &&
+               input.pressedThisTick(InputController::indexShoot) &&
+               input.releasedThisTick(InputController::indexShoot);
+    };
+    uint64_t taps = 0, mismatches = 0;
+    for (unsigned round = 0; round < levels; ++round) {
+        const int frozenTicks = rng::random<8>();
+        const int tapTick = rng::random(frozenTicks + 1);
+        bool valid = true;
+        for (int tick = 0; tick <= frozenTicks; ++tick) {
+            if (tick == tapTick) {
+                send(sf::Event::KeyPressed);
+                send(sf::Event::KeyReleased);
+                ++taps;
+            }
+            input.update(high_resolution_clock::now());
+            if (tick < frozenTicks) {
+                continue;
+            }
+            valid = valid && tapped();
+            input.consumeEdges();
+        }
+        input.update(high_resolution_clock::now());
+        valid = valid && !input.shootPressed();
+        input.consumeEdges();
+        // Recorded after the tick was due
+        const time_point due = high_resolution_clock::now();
+        send(sf::Event::KeyPressed);
+        send(sf::Event::KeyReleased);
+        input.update(due);
+        valid = valid && !input.shootPressed();
+        input.consumeEdges();
+        input.update(high_resolution_clock::now());
+        valid = valid && tapped();
+        input.consumeEdges();
+        ++taps;
+        if (!valid && ++mismatches <= 10) {
+            std::cerr << "input: tap " << tapTick << " ticks into a "
+                      << frozenTicks << " tick freeze went missing"
+                      << std::endl;
+        }
+    }
+    std::cout << "input: " << taps << " taps, " << mismatches
+              << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+int runCheck(const CheckOptions & options) {
+    static const std::map<std::string, std::function<bool(unsigned)>>
+        checks = {{"collision", checkCollision},
+                  {"input", checkInput},
+                  {"jps", checkJumpPoints},
+                  {"paths", checkPaths},
+                  {"queue", checkPathQueue},
+                  {"raycast", checkRaycast},
+                  {"spatial", checkSpatialHash},
+                  {"sweep", checkSweep}};
+    auto found = checks.find(options.name);
+    if (found == checks.end()) {
+        std::cerr << "unknown check " << options.name << ", try one of:";
+        for (auto & check : checks) {
+            std::cerr << ' ' << check.first;
+        }
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+    }
+    return found->second(options.levels) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+//
+// Checks that the fast paths agree with the straightforward code they
+// replaced, on freshly generated levels. Like --headless, they don't open a
+// window, so build machines can run them. Started from the command line with
+// --check <name> [levels], the exit status says whether they passed.
+//
+struct CheckOptions {
+    std::string name;
+    // How many levels to generate and test on
+    unsigned levels = 50;
+};
+
+int runCheck(const CheckOptions & options);
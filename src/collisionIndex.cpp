@@ -0,0 +1,43 @@
+#include "collisionIndex.hpp"
+
+// Nothing with a hit box is bigger than a tile, and the map is 61 tiles on a
+// side, so this leaves a few cells per bucket on a full map
+static const float cellSize = 32.f;
+static const uint32_t bucketCount = 1024;
+
+CollisionIndex::CollisionIndex()
+    : enemyTargets(cellSize, bucketCount), playerTargets(cellSize, bucketCount),
+      filed(), hashes() {}
+
+void CollisionIndex::fileForEnemies(EffectGroup & effects,
+                                    HelperGroup & helpers) {
+    enemyTargets.clear();
+    insert<EffectRef::PlayerShot>(enemyTargets,
+                                  effects.get<EffectRef::PlayerShot>());
+    insert<CollisionRef::Laika>(enemyTargets, helpers.get<HelperRef::Laika>());
+    if (enemyTargets.size()) {
+        enemyTargets.build();
+    }
+}
+
+void CollisionIndex::fileForPlayer(EffectGroup & effects,
+                                   enemyController & enemies) {
+    playerTargets.clear();
+    insert<EffectRef::EnemyShot>(playerTargets,
+                                 effects.get<EffectRef::EnemyShot>());
+    insert<EffectRef::DasherShot>(playerTargets,
+                                  effects.get<EffectRef::DasherShot>());
+    insert<EffectRef::TurretShot>(playerTargets,
+                                  effects.get<EffectRef::TurretShot>());
+    insert<EffectRef::Heart>(playerTargets, effects.get<EffectRef::Heart>());
+    insert<EffectRef::Coin>(playerTargets, effects.get<EffectRef::Coin>());
+    insert<EffectRef::GoldHeart>(playerTargets,
+                                 effects.get<EffectRef::GoldHeart>());
+    insert<CollisionRef::Critter>(playerTargets, enemies.getCritters());
+    insert<CollisionRef::Scoot>(playerTargets, enemies.getScoots());
+    insert<CollisionRef::Dasher>(playerTargets, enemies.getDashers());
+    insert<CollisionRef::Turret>(playerTargets, enemies.getTurrets());
+    if (playerTargets.size()) {
+        playerTargets.build();
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "HelperGroup.hpp"
+#include "effectsController.hpp"
+#include "enemyController.hpp"
+#include "framework/spatialHash.hpp"
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//
+// Kinds of thing that can be looked up in a CollisionIndex. The effects keep
+// their EffectRef numbers, everything else comes after them.
+//
+struct CollisionRef {
+    enum { Laika = EffectRef::Count, Critter, Scoot, Dasher, Turret, Count };
+};
+
+template <size_t kind> struct CollisionType {
+    using type = typename std::decay_t<decltype(
+        std::declval<EffectGroup &>().get<kind>())>::value_type::element_type;
+};
+template <> struct CollisionType<CollisionRef::Laika> { using type = Laika; };
+template <> struct CollisionType<CollisionRef::Critter> {
+    using type = Critter;
+};
+template <> struct CollisionType<CollisionRef::Scoot> { using type = Scoot; };
+template <> struct CollisionType<CollisionRef::Dasher> { using type = Dasher; };
+template <> struct CollisionType<CollisionRef::Turret> { using type = Turret; };
+
+// Boxes that sweep are filed by the rectangle around their whole move, this
+// then follows the move itself. Anything else was already tested exactly.
+template <typename Box, typename HBox>
+bool overlapsAlongMove(const Box &, const HBox &) {
+    return true;
+}
+template <int16_t w, int16_t h, int16_t xOff, int16_t yOff, typename HBox>
+bool overlapsAlongMove(const SweptHitBox<w, h, xOff, yOff> & box,
+                       const HBox & other) {
+    return box.overlapping(other);
+}
+
+//
+// Every shot, item, helper and enemy with a hit box, filed by position once
+// per tick so that collision checks only look at what's nearby instead of
+// everything on the map. Each kind is filed once, right before whoever looks
+// for it, and a kind with only a few elements isn't hashed at all: going
+// through a handful of boxes beats looking up the cells around one. Results
+// come back in the same order as the groups they were filed from, so code
+// switching over from a loop behaves the same.
+//
+class CollisionIndex {
+public:
+    CollisionIndex();
+    // What the enemies look for, the player's shots and Laika. Game files
+    // these once Laika has moved, before the enemies update.
+    void fileForEnemies(EffectGroup &, HelperGroup &);
+    // What the player looks for, the enemies' shots, items and the enemies
+    // themselves. Game files these once the enemies have moved and dropped
+    // items, before the player updates.
+    void fileForPlayer(EffectGroup &, enemyController &);
+    // Calls hook(T &) for each element of the kind whose hit box overlaps
+    // hitBox, T being the kind's element type. The hook may kill or hit what
+    // it's passed, but must not query the index again. Finds nothing if the
+    // kind hasn't been filed yet.
+    template <size_t kind, typename HBox, typename F>
+    void forEachOverlapping(const HBox & hitBox, const F & hook) {
+        using T = typename CollisionType<kind>::type;
+        if (!hashes[kind]) {
+            const auto * elements =
+                static_cast<const std::vector<std::shared_ptr<T>> *>(
+                    filed[kind]);
+            if (!elements) {
+                return;
+            }
+            for (const auto & element : *elements) {
+                const auto & box = element->getHitBox();
+                if (hitBox.overlapping(box) && overlapsAlongMove(box, hitBox)) {
+                    hook(*element);
+                }
+            }
+            return;
+        }
+        hashes[kind]->query(
+            kind, hitBox.getXPos(), hitBox.getYPos(), hitBox.getWidth(),
+            hitBox.getHeight(),
+            [&hook, &hitBox](const SpatialHash::Entry & entry) {
+                T & element = *static_cast<T *>(entry.object);
+                if (overlapsAlongMove(element.getHitBox(), hitBox)) {
+                    hook(element);
+                }
+            });
+    }
+
+private:
+    // Fewer of a kind than this and it's cheaper to test them all than to
+    // hash them, see --bench hits
+    static const size_t hashThreshold = 48;
+    SpatialHash enemyTargets, playerTargets;
+    // Each kind's vector as last filed, and the hash it went into, null
+    // where it was too small to hash
+    const void * filed[CollisionRef::Count];
+    SpatialHash * hashes[CollisionRef::Count];
+    template <size_t kind, typename T>
+    void insert(SpatialHash & hash,
+                const std::vector<std::shared_ptr<T>> & elements) {
+        filed[kind] = &elements;
+        hashes[kind] = nullptr;
+        if (elements.size() < hashThreshold) {
+            return;
+        }
+        hashes[kind] = &hash;
+        for (const auto & element : elements) {
+            const auto & hitBox = element->getHitBox();
+            hash.insert(kind, hitBox.getXPos(), hitBox.getYPos(),
+                        hitBox.getWidth(), hitBox.getHeight(), element.get());
+        }
+    }
+};
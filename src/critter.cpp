@@ -4,10 +4,9 @@
 #include "tileController.hpp"
 #include <cmath>
 
-Critter::Critter(const sf::Texture & txtr, Tile _map[61][61], float _xInit,
-                 float _yInit)
+Critter::Critter(const sf::Texture & txtr, float _xInit, float _yInit)
     : Enemy(_xInit, _yInit), xInit(_xInit), yInit(_yInit), currentDir(0.f),
-      spriteSheet(txtr), awake(false), active(true), recalc(4), map(_map) {
+      spriteSheet(txtr), awake(false), moving(false) {
     health = 3;
     spriteSheet.setOrigin(9, 9);
     shadow.setOrigin(9, 9);
@@ -21,29 +20,28 @@ const Critter::HBox & Critter::getHitBox() const { return hitBox; }
 void Critter::updatePlayerDead() { frameIndex = 0; }
 
 void Critter::update(Game * pGame, const sf::Time & elapsedTime,
-                     tileController & tiles) {
+                     tileController & tiles, bool active) {
     position.x = xInit + 12;
     position.y = yInit;
     EffectGroup & effects = pGame->getEffects();
     Player & player = pGame->getPlayer();
-    for (auto & element : effects.get<EffectRef::PlayerShot>()) {
-        if (element->getHitBox().overlapping(hitBox) &&
-            element->checkCanPoof()) {
+    CollisionIndex & collisions = pGame->getCollisionIndex();
+    collisions.forEachOverlapping<EffectRef::PlayerShot>(
+        hitBox, [this](PlayerShot & shot) {
+            if (!shot.checkCanPoof()) {
+                return;
+            }
             if (health == 1) {
-                element->disablePuff();
-                element->setKillFlag();
+                shot.disablePuff();
+                shot.setKillFlag();
             }
-            element->poof();
+            shot.poof();
             health -= 1;
             colored = true;
             colorAmount = 1.f;
-        }
-    }
-    for (auto & helper : pGame->getHelperGroup().get<HelperRef::Laika>()) {
-        if (hitBox.overlapping(helper->getHitBox())) {
-            health = 0;
-        }
-    }
+        });
+    collisions.forEachOverlapping<CollisionRef::Laika>(
+        hitBox, [this](Laika &) { health = 0; });
     if (health == 0) {
         unsigned long int temp = rng::random<5>();
         if (temp == 0) {
@@ -83,46 +81,35 @@ void Critter::update(Game * pGame, const sf::Time & elapsedTime,
         } else {
             speed = 0.7;
         }
-        // If the enemy is finished following its path to the player
-        if (path.empty() || recalc == 0) {
-            recalc = 8;
-
-            aStrCoordinate origin, target;
-            origin.x = (position.x - tilePosX) / 32;
-            origin.y = (position.y - tilePosY) / 26;
-            target.x = (tilePosX - player.getXpos() - 12) / -32;
-            target.y = (tilePosY - player.getYpos() - 32) / -26;
-            if (isTileWalkable(map[target.x][target.y])) {
-                path = astar_path(target, origin, map);
-                previous = path.back();
-                path.pop_back();
-                xInit = ((position.x - tilePosX) / 32) * 32 + tilePosX;
-                yInit = ((position.y - tilePosY) / 26) * 26 + tilePosY;
-                // Calculate the direction to move in, based on the coordinate
-                // of the previous location and the coordinate of the next
-                // location
-                currentDir =
-                    atan2(yInit - (((path.back().y * 26) + 4 + tilePosY)),
-                          xInit - (((path.back().x * 32) + 4 + tilePosX)));
+        // The player's flow field says which tile to head for next, and
+        // follows the player around, so there's no path to keep or replan
+        const FlowField & field = pGame->getPlayerField();
+        const auto headFor = [&](int x, int y) {
+            if (!field.reaches(x, y) || field.isGoal(x, y)) {
+                moving = false;
+                return;
             }
-        } else if (!path.empty()) {
+            step = field.next(x, y);
+            moving = true;
+            // Calculate the direction to move in, based on the current
+            // position and the coordinate of the next location
+            currentDir = atan2(yInit - (((step.y * 26) + 4 + tilePosY)),
+                               xInit - (((step.x * 32) + 4 + tilePosX)));
+        };
+        if (!moving) {
+            headFor((position.x - tilePosX) / 32, (position.y - tilePosY) / 26);
+        } else {
             // Add each component of the direction vector to the enemy's
             // position datafields
             xInit -= speed * cos(currentDir) *
                      (elapsedTime.asMicroseconds() * 0.00005f);
             yInit -= speed * sin(currentDir) *
                      (elapsedTime.asMicroseconds() * 0.00005f);
-            // If the enemy is sufficiently close to the target point, pop it
-            // and work on the next one
-            if (fabs(xInit - (((path.back().x * 32) + 4 + tilePosX))) < 8 &&
-                fabs(yInit - (((path.back().y * 26) + 4 + tilePosY))) < 8) {
-                recalc--;
-                previous = path.back();
-                path.pop_back();
-                // Calculate the direction to move in
-                currentDir =
-                    atan2(yInit - (((path.back().y * 26) + 4 + tilePosY)),
-                          xInit - (((path.back().x * 32) + 4 + tilePosX)));
+            // If the enemy is sufficiently close to the target point, work
+            // on the next one
+            if (fabs(xInit - (((step.x * 32) + 4 + tilePosX))) < 8 &&
+                fabs(yInit - (((step.y * 26) + 4 + tilePosY))) < 8) {
+                headFor(step.x, step.y);
             }
         }
 
@@ -162,8 +149,3 @@ const sf::Sprite & Critter::getSprite() const {
     return spriteSheet[frameIndex];
 }
 
-void Critter::activate() { active = true; }
-
-void Critter::deActivate() { active = false; }
-
-bool Critter::isActive() { return active; }
@@ -9,17 +9,17 @@
 class tileController;
 
 class Game;
+class Player;
 
 class Critter : public Enemy {
 public:
     using HBox = HitBox<12, 12, 4, -3>;
-    Critter(const sf::Texture &, Tile map[61][61], float, float);
-    void update(Game *, const sf::Time &, tileController & tiles);
+    Critter(const sf::Texture &, float, float);
+    // A critter that isn't active is crowding another one, and moves at half
+    // speed so that they spread out
+    void update(Game *, const sf::Time &, tileController & tiles, bool active);
     const sf::Sprite & getSprite() const;
     const sf::Sprite & getShadow() const;
-    void activate();
-    void deActivate();
-    bool isActive();
     void updatePlayerDead();
     const HBox & getHitBox() const;
 
@@ -27,13 +27,10 @@ private:
     float xInit, yInit;
     float currentDir;
     mutable SpriteSheet<0, 57, 18, 18> spriteSheet;
-    std::vector<aStrCoordinate> path;
-    aStrCoordinate previous;
+    // The tile being headed for, while moving
+    aStrCoordinate step;
     sf::Sprite shadow;
     HBox hitBox;
     bool awake;
-    bool active;
-    int recalc;
-    Tile (*map)[61]; //*** I know this is a nasty solution, perhaps there's a
-                        // better way to not store it locally...
+    bool moving;
 };
@@ -1,6 +1,7 @@
 #include "dasher.hpp"
 #include "Game.hpp"
 #include "angleFunction.hpp"
+#include <algorithm>
 #include <cmath>
 
 Dasher::Blur::Blur(sf::Sprite * spr, float xInit, float yInit) {
@@ -55,30 +56,29 @@ const sf::Sprite & Dasher::getSprite() const {
 
 const sf::Sprite & Dasher::getShadow() const { return shadow; }
 
-void Dasher::update(Game * pGame, const std::vector<wall> & walls,
+void Dasher::update(Game * pGame, const tileController & tiles,
                     const sf::Time & elapsedTime) {
     auto & effects = pGame->getEffects();
     auto & details = pGame->getDetails();
     auto & player = pGame->getPlayer();
     if (health > 0) {
-        for (auto & element : effects.get<EffectRef::PlayerShot>()) {
-            if (hitBox.overlapping(element->getHitBox()) &&
-                element->checkCanPoof()) {
+        CollisionIndex & collisions = pGame->getCollisionIndex();
+        collisions.forEachOverlapping<EffectRef::PlayerShot>(
+            hitBox, [this](PlayerShot & shot) {
+                if (!shot.checkCanPoof()) {
+                    return;
+                }
                 if (health == 1) {
-                    element->disablePuff();
-                    element->setKillFlag();
+                    shot.disablePuff();
+                    shot.setKillFlag();
                 }
-                element->poof();
+                shot.poof();
                 health -= 1;
                 colored = true;
                 colorAmount = 1.f;
-            }
-        }
-        for (auto & helper : pGame->getHelperGroup().get<HelperRef::Laika>()) {
-            if (hitBox.overlapping(helper->getHitBox())) {
-                health = 0;
-            }
-        }
+            });
+        collisions.forEachOverlapping<CollisionRef::Laika>(
+            hitBox, [this](Laika &) { health = 0; });
         if (health == 0) {
 	    hSpeed = 0;
 	    vSpeed = 0;
@@ -115,7 +115,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
     Enemy::updateColor(elapsedTime);
     dasherSheet.setPosition(position.x + 4, position.y);
     shadow.setPosition(position.x - 4, position.y + 22);
-    hitBox.setPosition(position.x, position.y);
+    hitBox.sweepTo(position.x, position.y);
     timer += elapsedTime.asMilliseconds();
     auto facePlayer = [this, player]() {
         if (this->position.x > player.getXpos()) {
@@ -204,17 +204,12 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
             sounds.play(ResHandler::Sound::wooshMono, this->shared_from_this(),
                         220.f, 5.f);
             frameIndex = 2;
-            uint8_t tries{0};
             float dir{static_cast<float>(rng::random<359>())};
-            do {
-                tries++;
-                if (tries > 254) {
-                    state = State::shootBegin;
-                    frameIndex = 3;
-                    goto begin;
-                }
-                dir += 12;
-            } while (wallInPath(walls, dir, position.x, position.y));
+            if (!findClearPath(tiles, dir, 12, 254, position.x, position.y)) {
+                state = State::shootBegin;
+                frameIndex = 3;
+                goto begin;
+            }
             hSpeed = 5 * cos(dir);
             vSpeed = 5 * sin(dir);
             if (hSpeed > 0) {
@@ -241,7 +236,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
             vSpeed = 0.f;
         }
 
-        if (Enemy::checkWallCollision(walls, position.x, position.y)) {
+        if (Enemy::checkWallCollision(tiles, position.x, position.y)) {
             hSpeed *= -1.f;
             vSpeed *= -1.f;
         }
@@ -268,8 +263,24 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
         }
     }
 
-    position.x += hSpeed * (elapsedTime.asMicroseconds() * 0.00005f);
-    position.y += vSpeed * (elapsedTime.asMicroseconds() * 0.00005f);
+    float dx = hSpeed * (elapsedTime.asMicroseconds() * 0.00005f);
+    float dy = vSpeed * (elapsedTime.asMicroseconds() * 0.00005f);
+    if (dx != 0.f || dy != 0.f) {
+        // A long tick could carry a dash through a wall, stop a pixel short
+        // of it instead and bounce off like the check above would have
+        const float t = wallSweep(tiles, position.x, position.y,
+                                  position.x + dx, position.y + dy);
+        if (t < 1.f) {
+            const float stop =
+                std::max(t - 1.f / std::sqrt(dx * dx + dy * dy), 0.f);
+            dx *= stop;
+            dy *= stop;
+            hSpeed *= -1.f;
+            vSpeed *= -1.f;
+        }
+    }
+    position.x += dx;
+    position.y += dy;
 }
 
 Dasher::State Dasher::getState() const { return state; }
@@ -9,7 +9,8 @@ class Game;
 
 class Dasher : public Enemy, public std::enable_shared_from_this<Dasher> {
 public:
-    using HBox = HitBox<20, 32, -6, -4>;
+    // Swept, a dash can cover more than the dasher's width in a tick
+    using HBox = SweptHitBox<20, 32, -6, -4>;
     struct Blur {
         Blur(sf::Sprite *, float, float);
         sf::Sprite * getSprite();
@@ -33,7 +34,7 @@ public:
     Dasher(const sf::Texture &, float, float);
     const sf::Sprite & getSprite() const;
     const sf::Sprite & getShadow() const;
-    void update(Game * pGame, const std::vector<wall> &, const sf::Time &);
+    void update(Game * pGame, const tileController &, const sf::Time &);
     std::vector<Dasher::Blur> * getBlurEffects();
     State getState() const;
     const sf::Vector2f & getScale() const;
@@ -1,4 +1,6 @@
 #include "enemy.hpp"
+#include "tileController.hpp"
+#include "wallCollision.hpp"
 
 Enemy::Enemy(float _xPos, float _yPos)
     : Object(_xPos, _yPos), colored(false), colorAmount(0.f), frameIndex(0),
@@ -8,41 +10,36 @@ float Enemy::getColorAmount() const { return colorAmount; }
 
 bool Enemy::isColored() const { return colored; }
 
-uint_fast8_t Enemy::checkWallCollision(const std::vector<wall> & w, float xPos,
-                                       float yPos) {
-    uint_fast8_t collisionMask = 0;
-    for (auto & element : w) {
-        if ((xPos + 6 < (element.getPosX() + element.getWidth()) &&
-             (xPos + 6 > (element.getPosX()))) &&
-            (fabs((yPos + 16) - element.getPosY()) <= 13)) {
-            collisionMask |= 0x01;
-        }
+uint_fast8_t Enemy::checkWallCollision(const tileController & tiles,
+                                       float xPos, float yPos) {
+    return wallCollisionMask(tiles, xPos, yPos);
+}
 
-        if ((xPos + 24 > (element.getPosX()) &&
-             (xPos + 24 < (element.getPosX() + element.getWidth()))) &&
-            (fabs((yPos + 16) - element.getPosY()) <= 13)) {
-            collisionMask |= 0x02;
-        }
+// How far ahead wallInPath() looks, the near end leaves out walls the enemy
+// is already brushing against
+static const float pathStart = 10.f, pathEnd = 90.f;
 
-        if (((yPos + 22 < (element.getPosY() + element.getHeight())) &&
-             (yPos + 22 > (element.getPosY()))) &&
-            (fabs((xPos)-element.getPosX()) <= 16)) {
-            collisionMask |= 0x04;
-        }
+// Scratch space for findClearPath(), kept around so that searching doesn't
+// allocate. One per thread, so that it stays safe to call from any thread.
+static thread_local std::vector<WallFootprint> nearbyWalls;
 
-        if (((yPos + 36 > element.getPosY()) &&
-             (yPos + 36 < element.getPosY() + element.getHeight())) &&
-            (fabs((xPos)-element.getPosX()) <= 16)) {
-            collisionMask |= 0x08;
-        }
-    }
-    return collisionMask;
+bool Enemy::wallInPath(const tileController & tiles, float dir, float xPos,
+                       float yPos) {
+    const float dx = cos(dir), dy = sin(dir);
+    return wallAlongSegment(tiles, xPos + dx * pathStart, yPos + dy * pathStart,
+                            xPos + dx * pathEnd, yPos + dy * pathEnd);
 }
 
-bool Enemy::wallInPath(const std::vector<wall> & w, float dir, float xPos,
-                       float yPos) {
-    for (int i{10}; i < 100; i += 16) {
-        if (checkWallCollision(w, xPos + cos(dir) * i, yPos + sin(dir) * i)) {
+bool Enemy::findClearPath(const tileController & tiles, float & dir,
+                          float step, unsigned tries, float xPos, float yPos) {
+    gatherWallFootprints(tiles, xPos, yPos, pathEnd, nearbyWalls);
+    const float x = xPos - tiles.posX, y = yPos - tiles.posY;
+    while (tries-- > 0) {
+        dir += step;
+        const float dx = cos(dir), dy = sin(dir);
+        if (!footprintsAlongSegment(nearbyWalls, x + dx * pathStart,
+                                    y + dy * pathStart, x + dx * pathEnd,
+                                    y + dy * pathEnd)) {
             return true;
         }
     }
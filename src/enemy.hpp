@@ -3,18 +3,27 @@
 #include "effectsController.hpp"
 #include "framework/framework.hpp"
 #include "wall.hpp"
+#include "wallCollision.hpp"
 #include <SFML/Graphics.hpp>
 #include <cmath>
 #include <vector>
 
+class tileController;
+
 class Enemy : public Object {
 protected:
     bool colored;
     float colorAmount;
     uint8_t frameIndex, health;
     uint32_t colorTimer, frameTimer;
-    uint_fast8_t checkWallCollision(const std::vector<wall> &, float, float);
-    bool wallInPath(const std::vector<wall> &, float, float, float);
+    uint_fast8_t checkWallCollision(const tileController &, float, float);
+    // Whether there's a wall within 90 pixels in direction dir
+    bool wallInPath(const tileController &, float, float, float);
+    // Turns dir by step until wallInPath() would find the way clear, giving
+    // up after tries turns. Gathers the walls in reach once, rather than
+    // looking them up again for each direction.
+    bool findClearPath(const tileController &, float & dir, float step,
+                       unsigned tries, float xPos, float yPos);
     void updateColor(const sf::Time &);
     void facePlayer();
     ~Enemy(){};
@@ -7,38 +7,32 @@
 #include "wall.hpp"
 #include <cmath>
 
-enemyController::enemyController() {}
+// How far offscreen an enemy still gets drawn and keeps updating
+static const float enemyMargin = 32.f;
 
-void enemyController::draw(drawableVec & gameObjects, drawableVec & gameShadows,
-                           Camera & camera) {
-    const sf::View & cameraView = camera.getOverworldView();
-    sf::Vector2f viewCenter = cameraView.getCenter();
-    sf::Vector2f viewSize = cameraView.getSize();
-    for (auto & element : turrets) {
-        if (element->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-            element->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-            element->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-            element->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-            std::tuple<sf::Sprite, float, Rendertype, float> shadow;
-            std::get<0>(shadow) = element->getShadow();
-            gameShadows.push_back(shadow);
-            std::tuple<sf::Sprite, float, Rendertype, float> tSpr;
-            std::get<0>(tSpr) = element->getSprite();
-            std::get<1>(tSpr) = element->getPosition().y;
-            if (element->colored()) {
-                std::get<2>(tSpr) = Rendertype::shadeWhite;
-            } else {
-                std::get<2>(tSpr) = Rendertype::shadeDefault;
-            }
-            gameObjects.push_back(tSpr);
+enemyController::enemyController() : critterGrid(12.f, 256) {}
+
+void enemyController::draw(GfxContext & gfx, const ViewCuller & culler) {
+    drawableVec & gameObjects = gfx.faces;
+    drawableVec & gameShadows = gfx.shadows;
+    culler.forEachVisible(turrets, enemyMargin, [&](const auto & element) {
+        std::tuple<sf::Sprite, float, Rendertype, float> shadow;
+        std::get<0>(shadow) = element->getShadow();
+        gameShadows.push_back(shadow);
+        std::tuple<sf::Sprite, float, Rendertype, float> tSpr;
+        std::get<0>(tSpr) = element->getSprite();
+        std::get<1>(tSpr) = element->getPosition().y;
+        if (element->colored()) {
+            std::get<2>(tSpr) = Rendertype::shadeWhite;
+        } else {
+            std::get<2>(tSpr) = Rendertype::shadeDefault;
         }
-    }
-    for (auto & element : critters) {
+        gameObjects.push_back(tSpr);
+    });
+    culler.forEachVisible(critters, enemyMargin, [&](const auto & element) {
+        const GfxContext::Mark mark = gfx.mark();
         gameShadows.emplace_back(element->getShadow(), 0.f,
                                  Rendertype::shadeDefault, 0.f);
-        std::tuple<sf::Sprite, float, Rendertype, float> tSpr;
-        std::get<0>(tSpr) = element->getSprite();
-        std::get<1>(tSpr) = element->getPosition().y - 16;
         // If the enemy should be colored, let the rendering code know to pass
         // it through a fragment shader
         if (element->isColored()) {
@@ -50,179 +44,160 @@ void enemyController::draw(drawableVec & gameObjects, drawableVec & gameShadows,
                                      element->getPosition().y - 16,
                                      Rendertype::shadeDefault, 0.f);
         }
-    }
-    for (auto & element : scoots) {
-        if (element->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-            element->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-            element->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-            element->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-            gameShadows.emplace_back(element->getShadow(), 0.f,
+        gfx.recordMotion(mark, element->getTickDelta());
+    });
+    culler.forEachVisible(scoots, enemyMargin, [&](const auto & element) {
+        const GfxContext::Mark mark = gfx.mark();
+        gameShadows.emplace_back(element->getShadow(), 0.f,
+                                 Rendertype::shadeDefault, 0.f);
+        if (element->isColored()) {
+            gameObjects.emplace_back(
+                element->getSprite(), element->getPosition().y - 16,
+                Rendertype::shadeWhite, element->getColorAmount());
+        } else {
+            gameObjects.emplace_back(element->getSprite(),
+                                     element->getPosition().y - 16,
                                      Rendertype::shadeDefault, 0.f);
-            if (element->isColored()) {
-                gameObjects.emplace_back(
-                    element->getSprite(), element->getPosition().y - 16,
-                    Rendertype::shadeWhite, element->getColorAmount());
-            } else {
-                gameObjects.emplace_back(element->getSprite(),
-                                         element->getPosition().y - 16,
-                                         Rendertype::shadeDefault, 0.f);
-            }
         }
-    }
-    for (auto & element : dashers) {
-        if (element->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-            element->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-            element->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-            element->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-            auto state = element->getState();
-	    gameShadows.emplace_back(element->getShadow(), 0.f,
-				     Rendertype::shadeDefault, 0.f);
-            for (auto & blur : *element->getBlurEffects()) {
-                gameObjects.emplace_back(*blur.getSprite(), blur.yInit + 200,
-                                         Rendertype::shadeDefault, 0.f);
-            }
-            if (element->isColored()) {
-                gameObjects.emplace_back(
-                    element->getSprite(), element->getPosition().y,
-                    Rendertype::shadeWhite, element->getColorAmount());
-            } else {
-                gameObjects.emplace_back(element->getSprite(),
-                                         element->getPosition().y,
-                                         Rendertype::shadeDefault, 0.f);
-            }
+        gfx.recordMotion(mark, element->getTickDelta());
+    });
+    culler.forEachVisible(dashers, enemyMargin, [&](const auto & element) {
+        // The blur trail stays where it was left, so it is emitted before
+        // the mark and doesn't move with the dasher
+        for (auto & blur : *element->getBlurEffects()) {
+            gameObjects.emplace_back(*blur.getSprite(), blur.yInit + 200,
+                                     Rendertype::shadeDefault, 0.f);
         }
-    }
+        const GfxContext::Mark mark = gfx.mark();
+        gameShadows.emplace_back(element->getShadow(), 0.f,
+                                 Rendertype::shadeDefault, 0.f);
+        if (element->isColored()) {
+            gameObjects.emplace_back(element->getSprite(),
+                                     element->getPosition().y,
+                                     Rendertype::shadeWhite,
+                                     element->getColorAmount());
+        } else {
+            gameObjects.emplace_back(element->getSprite(),
+                                     element->getPosition().y,
+                                     Rendertype::shadeDefault, 0.f);
+        }
+        gfx.recordMotion(mark, element->getTickDelta());
+    });
 }
 
-void enemyController::update(Game * pGame, bool enabled,
-                             const sf::Time & elapsedTime,
-                             std::vector<sf::Vector2f> & cameraTargets) {
-    EffectGroup & effectGroup = pGame->getEffects();
-    tileController & tileController = pGame->getTileController();
-    Camera & camera = pGame->getCamera();
-    Player * player = &pGame->getPlayer();
-    const sf::View & cameraView = camera.getOverworldView();
-    sf::Vector2f viewCenter = cameraView.getCenter();
-    sf::Vector2f viewSize = cameraView.getSize();
-    if (!turrets.empty()) {
-        for (auto it = turrets.begin(); it != turrets.end();) {
-            if ((*it)->getKillFlag() == 1) {
-                util::sleep(milliseconds(60));
-                camera.shake(0.17f);
-                it = turrets.erase(it);
-            } else {
-                if ((*it)->getPosition().x >
-                        viewCenter.x - viewSize.x / 2 - 32 &&
-                    (*it)->getPosition().x <
-                        viewCenter.x + viewSize.x / 2 + 32 &&
-                    (*it)->getPosition().y >
-                        viewCenter.y - viewSize.y / 2 - 32 &&
-                    (*it)->getPosition().y <
-                        viewCenter.y + viewSize.y / 2 + 32) {
-                    if (enabled) {
-                        (*it)->update(elapsedTime, pGame);
-                    }
-                    cameraTargets.emplace_back((*it)->getPosition().x,
-                                               (*it)->getPosition().y);
-                }
-                ++it;
-            }
+void enemyController::savePositions() {
+    const auto save = [](auto & vec) {
+        for (auto & element : vec) {
+            element->savePosition();
         }
-    }
-    if (!scoots.empty()) {
-        for (auto it = scoots.begin(); it != scoots.end();) {
+    };
+    save(turrets);
+    save(scoots);
+    save(dashers);
+    save(critters);
+}
+
+void enemyController::removeKilled(Game * pGame) {
+    Camera & camera = pGame->getCamera();
+    TimeScale & timeScale = pGame->getTimeScale();
+    const auto sweep = [&](auto & vec) {
+        for (auto it = vec.begin(); it != vec.end();) {
             if ((*it)->getKillFlag()) {
-                util::sleep(milliseconds(60));
+                timeScale.hitStop(sf::milliseconds(60));
                 camera.shake(0.17f);
-                it = scoots.erase(it);
+                it = vec.erase(it);
             } else {
-                if ((*it)->getPosition().x >
-                        viewCenter.x - viewSize.x / 2 - 32 &&
-                    (*it)->getPosition().x <
-                        viewCenter.x + viewSize.x / 2 + 32 &&
-                    (*it)->getPosition().y >
-                        viewCenter.y - viewSize.y / 2 - 32 &&
-                    (*it)->getPosition().y <
-                        viewCenter.y + viewSize.y / 2 + 32) {
-                    if (enabled) {
-                        (*it)->update(pGame, tileController.walls, elapsedTime);
-                    }
-                    cameraTargets.emplace_back((*it)->getPosition().x,
-                                               (*it)->getPosition().y);
-                }
                 ++it;
             }
         }
-    }
-    if (!critters.empty()) {
-        // Need to check if each enemy overlaps with any other enemies so that
-        // they don't bunch up
-        for (size_t i = 0; i < critters.size(); i++) {
-            for (size_t j = 0; j < critters.size(); j++) {
-                // Obviously it would be bad to compare an object to itself.
-                if (i != j) {
-                    // If the enemy at index i is active and overlaps with
-                    // another enemy that is also active...
-                    if (fabs(critters[i]->getPosition().x -
-                             critters[j]->getPosition().x) < 12 &&
-                        fabs(critters[i]->getPosition().y -
-                             critters[j]->getPosition().y) < 12 &&
-                        critters[i]->isActive() && critters[j]->isActive()) {
-                        critters[i]->deActivate();
-                    }
-                }
-            }
+    };
+    sweep(turrets);
+    sweep(scoots);
+    sweep(critters);
+    sweep(dashers);
+}
+
+void enemyController::update(Game * pGame, bool enabled,
+                             const sf::Time & elapsedTime,
+                             std::vector<sf::Vector2f> & cameraTargets) {
+    removeKilled(pGame);
+    tileController & tileController = pGame->getTileController();
+    const ViewCuller & culler = pGame->getViewCuller();
+    // An enemy's update comes down to a few lookups in the tile grid and the
+    // flow field, which costs less than waking the job system's workers
+    // would, so they all run here one at a time
+    // Only what's on screen wakes up
+    culler.forEachVisible(turrets, enemyMargin, [&](const auto & turret) {
+        if (enabled) {
+            turret->update(elapsedTime, pGame);
         }
-        for (auto it = critters.begin(); it != critters.end();) {
-            if ((*it)->getKillFlag()) {
-                util::sleep(milliseconds(60));
-                camera.shake(0.17f);
-                it = critters.erase(it);
-            } else {
-                if ((*it)->getPosition().x >
-                        viewCenter.x - viewSize.x / 2 - 32 &&
-                    (*it)->getPosition().x <
-                        viewCenter.x + viewSize.x / 2 + 32 &&
-                    (*it)->getPosition().y >
-                        viewCenter.y - viewSize.y / 2 - 32 &&
-                    (*it)->getPosition().y <
-                        viewCenter.y + viewSize.y / 2 + 32) {
-                    cameraTargets.emplace_back((*it)->getPosition().x,
-                                               (*it)->getPosition().y);
-                }
-                if (enabled) {
-                    (*it)->update(pGame, elapsedTime, tileController);
-                }
-                ++it;
-            }
+        cameraTargets.emplace_back(turret->getPosition().x,
+                                   turret->getPosition().y);
+    });
+    culler.forEachVisible(scoots, enemyMargin, [&](const auto & scoot) {
+        if (enabled) {
+            scoot->update(pGame, tileController, elapsedTime);
         }
-
-        // Now we have to reactivate all of the objects. Perhaps there is a
-        // smarter way than this brute force approach...
-        for (auto & element : critters) {
-            element->activate();
+        cameraTargets.emplace_back(scoot->getPosition().x,
+                                   scoot->getPosition().y);
+    });
+    // Critters chase the player from offscreen too, so they all update, but
+    // only the ones on screen draw the camera
+    culler.forEachVisible(critters, enemyMargin, [&](const auto & critter) {
+        cameraTargets.emplace_back(critter->getPosition().x,
+                                   critter->getPosition().y);
+    });
+    if (enabled && !critters.empty()) {
+        // Critters that crowd each other slow down so that they don't bunch
+        // up, see findCrowdedCritters()
+        findCrowdedCritters();
+        for (size_t i = 0; i < critters.size(); ++i) {
+            critters[i]->update(pGame, elapsedTime, tileController,
+                                activeCritters[i]);
         }
     }
-    if (!dashers.empty()) {
-	for (auto it = dashers.begin(); it != dashers.end();) {
-	    if ((*it)->getKillFlag()) {
-		util::sleep(milliseconds(60));
-		camera.shake(0.17f);
-		it = dashers.erase(it);
-	    } else {
-		if ((*it)->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-		    (*it)->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-		    (*it)->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-		    (*it)->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-		    if (enabled) {
-			(*it)->update(pGame, tileController.walls, elapsedTime);
-			cameraTargets.emplace_back((*it)->getPosition().x,
-						   (*it)->getPosition().y);
-		    }
-		}
-		++it;
-	    }
-	}
+    if (enabled) {
+        culler.forEachVisible(dashers, enemyMargin, [&](const auto & dasher) {
+            dasher->update(pGame, tileController, elapsedTime);
+            cameraTargets.emplace_back(dasher->getPosition().x,
+                                       dasher->getPosition().y);
+        });
+    }
+}
+
+void enemyController::findCrowdedCritters() {
+    // A critter comes within 12 pixels of another on each axis only if
+    // their 12 pixel cells are next to each other. The grid boxes are a
+    // pixel bigger all round so that float rounding can't hide a pair from
+    // the exact test below.
+    critterGrid.clear();
+    for (size_t i = 0; i < critters.size(); ++i) {
+        const sf::Vector2f & pos = critters[i]->getPosition();
+        critterGrid.insert(0, pos.x - 1.f, pos.y - 1.f, 14.f, 14.f,
+                           &critters[i]);
+    }
+    critterGrid.build();
+    // Same outcome as comparing every pair in order: a critter stays active
+    // unless it's near a later one, which hasn't been visited yet and so is
+    // still active, or near an earlier one that stayed active
+    activeCritters.assign(critters.size(), true);
+    for (size_t i = 0; i < critters.size(); ++i) {
+        const sf::Vector2f & pos = critters[i]->getPosition();
+        critterGrid.query(
+            0, pos.x - 1.f, pos.y - 1.f, 14.f, 14.f,
+            [this, i, &pos](const SpatialHash::Entry & entry) {
+                const size_t j = static_cast<std::shared_ptr<Critter> *>(
+                                     entry.object) -
+                                 critters.data();
+                if (j == i || !activeCritters[i] ||
+                    (j < i && !activeCritters[j])) {
+                    return;
+                }
+                const sf::Vector2f & other = critters[j]->getPosition();
+                if (fabs(pos.x - other.x) < 12 && fabs(pos.y - other.y) < 12) {
+                    activeCritters[i] = false;
+                }
+            });
     }
 }
 
@@ -280,7 +255,7 @@ void enemyController::addCritter(tileController * pTiles) {
     float yInit = (*pCoordVec)[locationSelect].y * 26 + pTiles->getPosY();
     critters.push_back(std::make_shared<Critter>(
         getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-        pTiles->mapArray, xInit, yInit));
+        xInit, yInit));
     (*pCoordVec)[locationSelect] = pCoordVec->back();
     pCoordVec->pop_back();
 }
@@ -1,13 +1,14 @@
 #pragma once
 
+#include "GfxContext.hpp"
 #include "RenderType.hpp"
 #include "critter.hpp"
 #include "dasher.hpp"
 #include "effectsController.hpp"
+#include "framework/spatialHash.hpp"
 #include "resourceHandler.hpp"
 #include "scoot.hpp"
 #include "turret.hpp"
-#include "util.hpp"
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <thread>
@@ -17,6 +18,7 @@ class detailController;
 class tileController;
 class Game;
 class Camera;
+class ViewCuller;
 
 class enemyController {
 private:
@@ -26,13 +28,20 @@ private:
     std::vector<std::shared_ptr<Scoot>> scoots;
     std::vector<std::shared_ptr<Dasher>> dashers;
     std::vector<std::shared_ptr<Critter>> critters;
+    // One bit per critter, cleared for those crowding another this tick
+    std::vector<bool> activeCritters;
+    SpatialHash critterGrid;
+    void findCrowdedCritters();
+    // Drops the enemies that died last tick, with a hit stop for each
+    void removeKilled(Game *);
     float windowW;
     float windowH;
 
 public:
     enemyController();
     void update(Game *, bool, const sf::Time &, std::vector<sf::Vector2f> &);
-    void draw(drawableVec &, drawableVec &, Camera &);
+    void draw(GfxContext &, const ViewCuller &);
+    void savePositions();
     void clear();
     void addTurret(tileController *);
     void addScoot(tileController *);
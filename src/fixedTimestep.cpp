@@ -0,0 +1,42 @@
+#include "fixedTimestep.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+FixedTimestep::FixedTimestep(nlohmann::json & config) {
+    int tickRate = 500;
+    int maxCatchUp = 8;
+    try {
+        auto it = config.find("Simulation");
+        if (it != config.end()) {
+            tickRate = it->value("TickRate", tickRate);
+            maxCatchUp = it->value("MaxCatchUpTicks", maxCatchUp);
+        }
+    } catch (const std::exception & ex) {
+        throw std::runtime_error("JSON error: " + std::string(ex.what()));
+    }
+    if (tickRate <= 0 || maxCatchUp <= 0) {
+        throw std::runtime_error(
+            "JSON error: Simulation TickRate and MaxCatchUpTicks must be "
+            "positive");
+    }
+    tickLength = sf::microseconds(1000000 / tickRate);
+    tickDuration = std::chrono::duration_cast<high_resolution_clock::duration>(
+        microseconds(tickLength.asMicroseconds()));
+    maxCatchUpTicks = maxCatchUp;
+    resync();
+}
+
+void FixedTimestep::resync() {
+    nextTick = high_resolution_clock::now() + tickDuration;
+}
+
+const time_point & FixedTimestep::getTickTime() const { return nextTick; }
+
+float FixedTimestep::getInterpolation(const time_point & tickTime) const {
+    const auto sinceTick = high_resolution_clock::now() - tickTime;
+    return std::min(
+        1.f, std::max(0.f, static_cast<float>(sinceTick.count()) /
+                               static_cast<float>(tickDuration.count())));
+}
+
+const sf::Time & FixedTimestep::getTickLength() const { return tickLength; }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "alias.hpp"
+#include <SFML/System.hpp>
+#include <json.hpp>
+#include <thread>
+
+//
+// Runs the game logic in ticks of a constant length, regardless of how long
+// each tick or frame actually takes. When the logic thread falls behind, the
+// missed ticks are simulated back to back, up to a limit; beyond that the
+// backlog is dropped instead, so that a hitch never turns into a huge step.
+// Each render snapshot is stamped with the time of the tick that produced it,
+// the render thread asks how far past that tick it is and uses the fraction to
+// interpolate positions between the last two ticks.
+//
+class FixedTimestep {
+public:
+    FixedTimestep(nlohmann::json &);
+    template <typename F> void advance(const F & update) {
+        unsigned ticksRun = 0;
+        while (high_resolution_clock::now() >= nextTick) {
+            if (ticksRun == maxCatchUpTicks) {
+                resync();
+                break;
+            }
+            update(tickLength);
+            nextTick += tickDuration;
+            ++ticksRun;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+    void resync();
+    // Only meaningful on the logic thread, while a tick is running
+    const time_point & getTickTime() const;
+    float getInterpolation(const time_point & tickTime) const;
+    const sf::Time & getTickLength() const;
+
+private:
+    sf::Time tickLength;
+    high_resolution_clock::duration tickDuration;
+    unsigned maxCatchUpTicks;
+    time_point nextTick;
+};
@@ -0,0 +1,61 @@
+#include "framePacer.hpp"
+#include <stdexcept>
+#include <thread>
+
+FramePacer::FramePacer(nlohmann::json & config) : mode(Mode::vsync) {
+    std::string pacing = "vsync";
+    int targetFrameRate = 120;
+    int spinMicroseconds = 2000;
+    try {
+        auto it = config.find("Display");
+        if (it != config.end()) {
+            pacing = it->value("FramePacing", pacing);
+            targetFrameRate = it->value("TargetFrameRate", targetFrameRate);
+            spinMicroseconds = it->value("SpinMicroseconds", spinMicroseconds);
+        }
+    } catch (const std::exception & ex) {
+        throw std::runtime_error("JSON error: " + std::string(ex.what()));
+    }
+    if (pacing == "vsync") {
+        mode = Mode::vsync;
+    } else if (pacing == "sleep-spin") {
+        mode = Mode::sleepSpin;
+    } else if (pacing == "uncapped") {
+        mode = Mode::uncapped;
+    } else {
+        throw std::runtime_error("JSON error: Display FramePacing must be one "
+                                 "of vsync, sleep-spin or uncapped");
+    }
+    if (targetFrameRate <= 0 || spinMicroseconds < 0) {
+        throw std::runtime_error("JSON error: Display TargetFrameRate must be "
+                                 "positive and SpinMicroseconds can't be "
+                                 "negative");
+    }
+    frameInterval = std::chrono::duration_cast<high_resolution_clock::duration>(
+        nanoseconds(1000000000 / targetFrameRate));
+    spinTime = microseconds(spinMicroseconds);
+}
+
+FramePacer::Mode FramePacer::getMode() const { return mode; }
+
+bool FramePacer::wait(high_resolution_clock::duration & wakeError) {
+    if (mode != Mode::sleepSpin) {
+        return false;
+    }
+    const time_point now = high_resolution_clock::now();
+    // After falling a whole frame behind (losing focus, loading a level),
+    // start the schedule over instead of rushing to catch up
+    if (nextFrame == time_point() || now - nextFrame > frameInterval) {
+        nextFrame = now;
+    }
+    if (nextFrame - now > spinTime) {
+        std::this_thread::sleep_until(nextFrame - spinTime);
+    }
+    time_point woke = high_resolution_clock::now();
+    while (woke < nextFrame) {
+        woke = high_resolution_clock::now();
+    }
+    wakeError = woke - nextFrame;
+    nextFrame += frameInterval;
+    return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "alias.hpp"
+#include <json.hpp>
+
+//
+// Decides when each frame gets presented, configured in the Display section
+// of config.json:
+//  - vsync: leave it to the driver's vertical sync
+//  - sleep-spin: sleep most of the way to the next frame at TargetFrameRate,
+//    then spin for the last SpinMicroseconds, since sleeping alone wakes up
+//    too late too often
+//  - uncapped: present as soon as each frame is ready
+// With sleep-spin, wait() also says how late it woke up, for the telemetry
+// report. The other modes have no wake up to be late for: vsync waits on a
+// refresh rate that SFML doesn't tell us, and uncapped doesn't wait at all.
+//
+class FramePacer {
+public:
+    enum class Mode { vsync, sleepSpin, uncapped };
+    FramePacer(nlohmann::json &);
+    Mode getMode() const;
+    // Call right before presenting the frame. Returns false when there's no
+    // wake error to report, otherwise writes it into wakeError.
+    bool wait(high_resolution_clock::duration & wakeError);
+
+private:
+    Mode mode;
+    high_resolution_clock::duration frameInterval, spinTime;
+    time_point nextFrame;
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <cmath>
@@ -18,10 +19,12 @@ using Sprite = sf::Sprite;
 class Object {
 protected:
     sf::Vector2f position{};
+    sf::Vector2f previousPosition{};
     bool killFlag = false;
     bool visible = false;
 public:
-    Object(float x, float y) : position{sf::Vector2f{x, y}} {}
+    Object(float x, float y) : position{sf::Vector2f{x, y}},
+			       previousPosition{sf::Vector2f{x, y}} {}
     virtual ~Object() {}
     inline void setPosition(sf::Vector2f _position) {
 	position = _position;
@@ -33,6 +36,16 @@ public:
     inline const sf::Vector2f & getPosition() const {
 	return position;
     }
+    // Remembers where the object was at the start of a logic tick, so that
+    // the renderer can draw it somewhere between the last two ticks.
+    inline void savePosition() {
+	previousPosition = position;
+    }
+    // How far the object has moved back since the start of the tick, the
+    // renderer scales this to draw it between its last two positions.
+    inline sf::Vector2f getTickDelta() const {
+	return previousPosition - position;
+    }
     inline bool getKillFlag() {
 	return killFlag;
     }
@@ -116,6 +129,87 @@ public:
     }
 };
 	
+//===========================================================//
+// The room a HitBox takes up while moving in a straight     //
+// line between two positions, for things that can move      //
+// further in one tick than they are wide. The getters give  //
+// the rectangle around the whole move, which is all that a  //
+// spatial index needs, and overlapping() follows the move   //
+// exactly, so that diagonal moves aren't generous at the    //
+// corners. When the box hasn't moved both agree with        //
+// HitBox::overlapping().                                    //
+//===========================================================//
+template<int16_t w, int16_t h, int16_t xOff = 0, int16_t yOff = 0>
+class SweptHitBox {
+    static_assert(w > 0 && h > 0, "Zero and negative values are not valid Hitbox side length parameters");
+    sf::Vector2f from{}, to{};
+    // Narrows [tMin, tMax] to the part of the move where the box's near
+    // edge start + delta * t is strictly between low and high
+    static bool clip(float start, float delta, float low, float high,
+		     float & tMin, float & tMax) {
+	if (delta == 0.f) {
+	    return start > low && start < high;
+	}
+	float t0 = (low - start) / delta, t1 = (high - start) / delta;
+	if (t0 > t1) {
+	    std::swap(t0, t1);
+	}
+	tMin = std::max(tMin, t0);
+	tMax = std::min(tMax, t1);
+	return true;
+    }
+public:
+    // Places the box without sweeping, as if it had always been there
+    void setPosition(float x, float y) {
+	from.x = to.x = x;
+	from.y = to.y = y;
+    }
+    // Sweeps the box from wherever it was last placed to (x, y)
+    void sweepTo(float x, float y) {
+	from = to;
+	to.x = x;
+	to.y = y;
+    }
+    void sweepTo(const sf::Vector2f & position) {
+	sweepTo(position.x, position.y);
+    }
+    const sf::Vector2f & getPosition() const {
+	return to;
+    }
+    float getWidth() const {
+	return w + std::abs(to.x - from.x);
+    }
+    float getHeight() const {
+	return h + std::abs(to.y - from.y);
+    }
+    float getXPos() const {
+	return std::min(from.x, to.x) + xOff;
+    }
+    float getYPos() const {
+	return std::min(from.y, to.y) + yOff;
+    }
+    template<typename T>
+    bool overlapping(const T & other) const {
+	const float x = from.x + xOff, y = from.y + yOff;
+	if (from == to) {
+	    return x < (other.getXPos() + other.getWidth()) &&
+		(x + w) > other.getXPos() &&
+		y < (other.getYPos() + other.getHeight()) &&
+		(y + h) > other.getYPos();
+	}
+	// Slide the box's corner along the move, against other grown by
+	// the box's size, with open ends like the test above
+	float tMin = -INFINITY, tMax = INFINITY;
+	if (!clip(x, to.x - from.x, other.getXPos() - w,
+		  other.getXPos() + other.getWidth(), tMin, tMax) ||
+	    !clip(y, to.y - from.y, other.getYPos() - h,
+		  other.getYPos() + other.getHeight(), tMin, tMax)) {
+	    return false;
+	}
+	return tMin < tMax && tMin < 1.f && tMax > 0.f;
+    }
+};
+
 //===========================================================//
 // Framework::Group is a structure that can hold any number  //
 // of classes of different type. It also provides an         //
@@ -141,6 +235,13 @@ public:
 		vec.clear();
 	    });
     }
+    size_t size() const {
+	size_t total = 0;
+	_utility_::for_each(contents, [&](const auto & vec) {
+		total += vec.size();
+	    });
+	return total;
+    }
     template<std::size_t indx>
     auto & get() {
 	return std::get<indx>(contents);
@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+//==========================================================================//
+// A fixed size histogram in the style of HdrHistogram. Values below 32 get //
+// a bucket each, above that every power of two is split into 16 buckets,   //
+// so any value reads back to within about 6% of what was recorded without  //
+// the memory use growing with the range. Meant for one recording thread;   //
+// the counts are relaxed atomics so that another thread can produce a      //
+// report at any time, although it may see a sample or two in flight.       //
+//==========================================================================//
+
+class Histogram {
+    static const unsigned linearBuckets = 32;
+    static const unsigned subBuckets = 16;
+    // Enough for values up to 2^32
+    static const unsigned maxShift = 28;
+    static const unsigned bucketCount =
+	linearBuckets + (maxShift - 1) * subBuckets;
+    std::array<std::atomic<uint32_t>, bucketCount> buckets;
+    std::atomic<uint64_t> count, max;
+    static unsigned indexOf(uint64_t value) {
+	if (value < linearBuckets) {
+	    return value;
+	}
+	unsigned shift = 0;
+	while ((value >> shift) >= linearBuckets) {
+	    ++shift;
+	}
+	if (shift > maxShift - 1) {
+	    return bucketCount - 1;
+	}
+	return linearBuckets + (shift - 1) * subBuckets +
+	    ((value >> shift) - subBuckets);
+    }
+    // The largest value that would land in the same bucket
+    static uint64_t highestEquivalent(unsigned index) {
+	if (index < linearBuckets) {
+	    return index;
+	}
+	const unsigned shift = (index - linearBuckets) / subBuckets + 1;
+	const uint64_t sub = (index - linearBuckets) % subBuckets + subBuckets;
+	return ((sub + 1) << shift) - 1;
+    }
+public:
+    Histogram() : count(0), max(0) {
+	for (auto & bucket : buckets) {
+	    bucket.store(0, std::memory_order_relaxed);
+	}
+    }
+    Histogram(const Histogram &) = delete;
+    Histogram & operator=(const Histogram &) = delete;
+    void record(uint64_t value) {
+	auto & bucket = buckets[indexOf(value)];
+	bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+		     std::memory_order_relaxed);
+	count.store(count.load(std::memory_order_relaxed) + 1,
+		    std::memory_order_relaxed);
+	if (value > max.load(std::memory_order_relaxed)) {
+	    max.store(value, std::memory_order_relaxed);
+	}
+    }
+    uint64_t getCount() const {
+	return count.load(std::memory_order_relaxed);
+    }
+    uint64_t getMax() const {
+	return max.load(std::memory_order_relaxed);
+    }
+    // Percentile on the range [0, 100], zero when nothing was recorded
+    uint64_t percentile(double p) const {
+	uint64_t total = 0;
+	for (auto & bucket : buckets) {
+	    total += bucket.load(std::memory_order_relaxed);
+	}
+	const uint64_t target =
+	    std::max<uint64_t>(std::ceil(total * (p / 100.0)), 1);
+	uint64_t seen = 0;
+	for (unsigned i = 0; i < bucketCount; ++i) {
+	    seen += buckets[i].load(std::memory_order_relaxed);
+	    if (seen >= target) {
+		return std::min(highestEquivalent(i), getMax());
+	    }
+	}
+	return 0;
+    }
+    // Samples that are certainly larger than threshold
+    uint64_t countAbove(uint64_t threshold) const {
+	uint64_t above = 0;
+	for (unsigned i = indexOf(threshold) + 1; i < bucketCount; ++i) {
+	    above += buckets[i].load(std::memory_order_relaxed);
+	}
+	return above;
+    }
+};
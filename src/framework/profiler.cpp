@@ -0,0 +1,149 @@
+#ifdef BLINDJUMP_PROFILE
+
+#include "profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace profiler {
+    namespace {
+	using steadyClock = std::chrono::steady_clock;
+	const steadyClock::time_point epoch = steadyClock::now();
+	// Per thread, about three megabytes
+	const uint64_t ringCapacity = 1 << 15;
+
+	struct Ring {
+	    std::unique_ptr<Event[]> events{new Event[ringCapacity]};
+	    std::atomic<uint64_t> head{0};
+	    std::string threadName;
+	    size_t tid = 0;
+	    // Set when the owning thread exits, so that threads spawned later
+	    // can take the ring over instead of allocating a new one
+	    bool retired = false;
+	};
+
+	struct Registry {
+	    std::mutex mutex;
+	    std::vector<std::unique_ptr<Ring>> rings;
+	};
+
+	Registry & registry() {
+	    static Registry instance;
+	    return instance;
+	}
+
+	struct RingHandle {
+	    Ring * ring = nullptr;
+	    ~RingHandle() {
+		if (ring) {
+		    std::lock_guard<std::mutex> lock(registry().mutex);
+		    ring->retired = true;
+		}
+	    }
+	};
+
+	Ring & localRing() {
+	    thread_local RingHandle handle;
+	    if (!handle.ring) {
+		Registry & reg = registry();
+		std::lock_guard<std::mutex> lock(reg.mutex);
+		auto found = std::find_if(reg.rings.begin(), reg.rings.end(),
+					  [](const std::unique_ptr<Ring> & r) {
+					      return r->retired;
+					  });
+		if (found != reg.rings.end()) {
+		    handle.ring = found->get();
+		    handle.ring->retired = false;
+		} else {
+		    reg.rings.emplace_back(new Ring);
+		    handle.ring = reg.rings.back().get();
+		    handle.ring->tid = reg.rings.size();
+		}
+	    }
+	    return *handle.ring;
+	}
+
+	void writeEvent(std::ostream & out, const Event & event, size_t tid) {
+	    out << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,"
+		<< "\"tid\":" << tid << ",\"ts\":" << event.start / 1000.0
+		<< ",\"dur\":" << event.duration / 1000.0;
+	    if (event.argCount) {
+		out << ",\"args\":{";
+		for (uint8_t i = 0; i < event.argCount; ++i) {
+		    out << (i ? "," : "") << '"' << event.args[i].key
+			<< "\":" << event.args[i].value;
+		}
+		out << '}';
+	    }
+	    out << '}';
+	}
+    }
+
+    int64_t now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	    steadyClock::now() - epoch).count();
+    }
+
+    void record(const Event & event) {
+	Ring & ring = localRing();
+	const uint64_t head = ring.head.load(std::memory_order_relaxed);
+	ring.events[head & (ringCapacity - 1)] = event;
+	ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    void nameThread(const char * name) {
+	Ring & ring = localRing();
+	std::lock_guard<std::mutex> lock(registry().mutex);
+	ring.threadName = name;
+    }
+
+    bool dump(const std::string & path) {
+	std::ofstream out(path);
+	if (!out) {
+	    return false;
+	}
+	out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+	bool first = true;
+	auto separate = [&out, &first]() {
+	    if (!first) {
+		out << ",\n";
+	    }
+	    first = false;
+	};
+	Registry & reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	std::vector<Event> copy;
+	for (auto & ring : reg.rings) {
+	    if (!ring->threadName.empty()) {
+		separate();
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+		    << "\"tid\":" << ring->tid << ",\"args\":{\"name\":\""
+		    << ring->threadName << "\"}}";
+	    }
+	    const uint64_t end = ring->head.load(std::memory_order_acquire);
+	    const uint64_t begin = end > ringCapacity ? end - ringCapacity : 0;
+	    copy.clear();
+	    for (uint64_t i = begin; i < end; ++i) {
+		copy.push_back(ring->events[i & (ringCapacity - 1)]);
+	    }
+	    // The owner may have lapped the oldest events while they were being
+	    // copied, including the slot it's writing to right now
+	    const uint64_t after = ring->head.load(std::memory_order_acquire);
+	    const uint64_t valid =
+		after + 1 > ringCapacity ? after + 1 - ringCapacity : 0;
+	    for (uint64_t i = std::max(begin, valid); i < end; ++i) {
+		separate();
+		writeEvent(out, copy[i - begin], ring->tid);
+	    }
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return static_cast<bool>(out);
+    }
+}
+
+#endif
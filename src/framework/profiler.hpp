@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+//==========================================================================//
+// A scoped zone profiler. A zone records its start time, its duration, and //
+// up to four integer arguments (entity counts and the like) into a ring    //
+// buffer owned by the thread that opened it, so recording never takes a    //
+// lock. dump() writes out every thread's ring in the Chrome trace event    //
+// format, which chrome://tracing and Perfetto can both open. It is only    //
+// compiled in when BLINDJUMP_PROFILE is defined, otherwise the macros at   //
+// the bottom expand to nothing.                                            //
+//==========================================================================//
+
+#ifdef BLINDJUMP_PROFILE
+
+namespace profiler {
+    struct Arg {
+	const char * key;
+	int64_t value;
+    };
+    struct Event {
+	static const uint8_t maxArgs = 4;
+	// Names and keys must outlive the profiler, string literals are best
+	const char * name;
+	// Nanoseconds since the program started
+	int64_t start, duration;
+	Arg args[maxArgs];
+	uint8_t argCount;
+    };
+    int64_t now();
+    void record(const Event & event);
+    // Labels the calling thread in the trace
+    void nameThread(const char * name);
+    // May be called while other threads are still recording, events that
+    // get overwritten while being copied out are left out of the trace
+    bool dump(const std::string & path);
+
+    class Zone {
+	Event event;
+    public:
+	explicit Zone(const char * name) {
+	    event.name = name;
+	    event.argCount = 0;
+	    event.start = now();
+	}
+	Zone(const Zone &) = delete;
+	Zone & operator=(const Zone &) = delete;
+	void arg(const char * key, int64_t value) {
+	    if (event.argCount < Event::maxArgs) {
+		event.args[event.argCount++] = Arg{key, value};
+	    }
+	}
+	~Zone() {
+	    event.duration = now() - event.start;
+	    record(event);
+	}
+    };
+
+    // Writes a trace when it goes out of scope, declare it before starting
+    // any threads so that they've all been joined by then
+    class DumpOnExit {
+	std::string path;
+    public:
+	explicit DumpOnExit(const std::string & _path) : path(_path) {}
+	DumpOnExit(const DumpOnExit &) = delete;
+	DumpOnExit & operator=(const DumpOnExit &) = delete;
+	~DumpOnExit() { dump(path); }
+    };
+}
+
+#define PROFILE_ZONE(var, name) profiler::Zone var(name)
+#define PROFILE_ARG(var, key, value) var.arg(key, static_cast<int64_t>(value))
+#define PROFILE_THREAD(name) profiler::nameThread(name)
+#define PROFILE_DUMP(path) profiler::dump(path)
+#define PROFILE_DUMP_ON_EXIT(path) profiler::DumpOnExit profilerDump(path)
+
+#else
+
+#define PROFILE_ZONE(var, name)
+#define PROFILE_ARG(var, key, value)
+#define PROFILE_THREAD(name)
+#define PROFILE_DUMP(path)
+#define PROFILE_DUMP_ON_EXIT(path)
+
+#endif
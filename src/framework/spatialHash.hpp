@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "boxBatch.hpp"
+
+//==========================================================================//
+// A uniform grid over world space, hashed into a fixed number of buckets   //
+// so that it doesn't care how big the world is. Each entry is an axis      //
+// aligned box with a small integer kind and an opaque pointer. Entries are //
+// filed under the cell holding their upper left corner only, queries widen //
+// their search by the largest box inserted instead, so nothing is ever     //
+// reported twice. Call clear(), insert() everything, then build() once     //
+// before querying; build() is a counting sort, and after the first few     //
+// frames neither it nor query() allocate. Each bucket's boxes are laid out //
+// in a BoxBatch, so a query tests them several at a time.                  //
+//==========================================================================//
+
+class SpatialHash {
+public:
+    struct Entry {
+	float x, y, w, h;
+	int32_t cellX, cellY;
+	uint32_t kind;
+	void * object;
+    };
+private:
+    float cellSize;
+    uint32_t bucketMask;
+    float maxW, maxH;
+    std::vector<Entry> entries;
+    // Index into sorted of the first entry in each bucket, plus one past the
+    // end, so bucket b spans [bucketStart[b], bucketStart[b + 1])
+    std::vector<uint32_t> bucketStart;
+    std::vector<uint32_t> sorted;
+    // The boxes in the same order as sorted
+    BoxBatch sortedBoxes;
+    std::vector<uint32_t> found;
+    int32_t cellOf(float coord) const {
+	return static_cast<int32_t>(std::floor(coord / cellSize));
+    }
+    uint32_t bucketOf(int32_t cellX, int32_t cellY) const {
+	return (static_cast<uint32_t>(cellX) * 73856093u ^
+		static_cast<uint32_t>(cellY) * 19349663u) & bucketMask;
+    }
+public:
+    // bucketCount must be a power of two
+    SpatialHash(float cellSize, uint32_t bucketCount) :
+	cellSize(cellSize), bucketMask(bucketCount - 1), maxW(0.f), maxH(0.f),
+	bucketStart(bucketCount + 1, 0) {}
+    void clear() {
+	entries.clear();
+	maxW = 0.f;
+	maxH = 0.f;
+    }
+    void insert(uint32_t kind, float x, float y, float w, float h,
+		void * object) {
+	entries.push_back({x, y, w, h, cellOf(x), cellOf(y), kind, object});
+	maxW = std::max(maxW, w);
+	maxH = std::max(maxH, h);
+    }
+    void build() {
+	std::fill(bucketStart.begin(), bucketStart.end(), 0);
+	for (const auto & entry : entries) {
+	    ++bucketStart[bucketOf(entry.cellX, entry.cellY) + 1];
+	}
+	for (size_t i = 1; i < bucketStart.size(); ++i) {
+	    bucketStart[i] += bucketStart[i - 1];
+	}
+	sorted.resize(entries.size());
+	// Walk backwards so that each bucket keeps insertion order
+	for (size_t i = entries.size(); i-- > 0;) {
+	    const Entry & entry = entries[i];
+	    const uint32_t bucket = bucketOf(entry.cellX, entry.cellY);
+	    sorted[--bucketStart[bucket + 1]] = i;
+	}
+	// The decrements above moved each bucket's end back to its start, so
+	// shift the whole table along by one
+	std::rotate(bucketStart.begin(), bucketStart.begin() + 1,
+		    bucketStart.end());
+	bucketStart.back() = entries.size();
+	sortedBoxes.clear();
+	for (uint32_t i : sorted) {
+	    const Entry & entry = entries[i];
+	    sortedBoxes.push(entry.x, entry.y, entry.w, entry.h);
+	}
+    }
+    size_t size() const {
+	return entries.size();
+    }
+    // Calls hook(entry) for every entry of the given kind whose box strictly
+    // overlaps (x, y, w, h), the same test HitBox::overlapping() uses, in
+    // the order the entries were inserted. The hook may change the objects
+    // but must not insert or query.
+    template<typename F>
+    void query(uint32_t kind, float x, float y, float w, float h,
+	       const F & hook) {
+	found.clear();
+	const int32_t minX = cellOf(x - maxW), maxX = cellOf(x + w);
+	const int32_t minY = cellOf(y - maxH), maxY = cellOf(y + h);
+	for (int32_t cellY = minY; cellY <= maxY; ++cellY) {
+	    for (int32_t cellX = minX; cellX <= maxX; ++cellX) {
+		const uint32_t bucket = bucketOf(cellX, cellY);
+		sortedBoxes.forEachOverlapping(
+		    x, y, w, h, bucketStart[bucket], bucketStart[bucket + 1],
+		    [&](size_t i) {
+			const Entry & entry = entries[sorted[i]];
+			// Other cells can hash to the same bucket
+			if (entry.kind == kind && entry.cellX == cellX &&
+			    entry.cellY == cellY) {
+			    found.push_back(sorted[i]);
+			}
+		    });
+	    }
+	}
+	std::sort(found.begin(), found.end());
+	for (uint32_t i : found) {
+	    hook(entries[i]);
+	}
+    }
+};
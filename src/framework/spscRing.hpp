@@ -0,0 +1,45 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+//==========================================================================//
+// A fixed size, lock-free queue for exactly one producer thread and one    //
+// consumer thread. push() fails rather than blocks when the ring is full,  //
+// front() peeks at the oldest element without removing it. Capacity must   //
+// be a power of two, one slot is always left empty.                        //
+//==========================================================================//
+
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity && !(Capacity & (Capacity - 1)),
+		  "SpscRing capacity must be a power of two");
+    static const size_t mask = Capacity - 1;
+    std::array<T, Capacity> slots;
+    std::atomic<size_t> head, tail;
+public:
+    SpscRing() : slots{}, head(0), tail(0) {}
+    SpscRing(const SpscRing &) = delete;
+    SpscRing & operator=(const SpscRing &) = delete;
+    bool push(const T & value) {
+	const size_t t = tail.load(std::memory_order_relaxed);
+	const size_t next = (t + 1) & mask;
+	if (next == head.load(std::memory_order_acquire)) {
+	    return false;
+	}
+	slots[t] = value;
+	tail.store(next, std::memory_order_release);
+	return true;
+    }
+    const T * front() const {
+	const size_t h = head.load(std::memory_order_relaxed);
+	if (h == tail.load(std::memory_order_acquire)) {
+	    return nullptr;
+	}
+	return &slots[h];
+    }
+    void pop() {
+	const size_t h = head.load(std::memory_order_relaxed);
+	head.store((h + 1) & mask, std::memory_order_release);
+    }
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+//==========================================================================//
+// Hands the latest copy of some state from one producer thread to one      //
+// consumer thread without locking. The producer fills back(), then calls   //
+// publish() to swap it with the middle slot; the consumer calls acquire()  //
+// to swap the middle slot with its front slot if anything new has been     //
+// published since. Neither side ever waits on the other, and the consumer  //
+// always sees the most recent complete copy.                               //
+//==========================================================================//
+
+template <typename T>
+class TripleBuffer {
+    static const uint8_t freshBit = 0x04;
+    static const uint8_t indexMask = 0x03;
+    T slots[3];
+    uint8_t backIdx, frontIdx;
+    std::atomic<uint8_t> middle;
+public:
+    explicit TripleBuffer(const T & init = T{}) :
+	slots{init, init, init}, backIdx(0), frontIdx(1), middle(2) {}
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer & operator=(const TripleBuffer &) = delete;
+    T & back() { return slots[backIdx]; }
+    void publish() {
+	backIdx = middle.exchange(backIdx | freshBit, std::memory_order_acq_rel)
+	    & indexMask;
+    }
+    const T & acquire() {
+	if (middle.load(std::memory_order_relaxed) & freshBit) {
+	    frontIdx = middle.exchange(frontIdx, std::memory_order_acq_rel)
+		& indexMask;
+	}
+	return slots[frontIdx];
+    }
+};
@@ -0,0 +1,26 @@
+#include "headless.hpp"
+#include "Game.hpp"
+#include "alias.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+int runHeadless(nlohmann::json & config, const HeadlessOptions & options) {
+    Game game(config, Game::Mode::headless);
+    while (game.getLevel() < options.level) {
+        game.nextLevel();
+    }
+    const sf::Time & tickLength = game.getTimestep().getTickLength();
+    const time_point start = high_resolution_clock::now();
+    for (uint64_t tick = 0; tick < options.ticks; ++tick) {
+        game.updateLogic(tickLength);
+    }
+    const duration elapsed = high_resolution_clock::now() - start;
+    std::cout << "headless: " << options.ticks << " ticks in "
+              << elapsed.count() << " s ("
+              << elapsed.count() * 1000000.0 /
+                     std::max<uint64_t>(options.ticks, 1)
+              << " us/tick), finished on level " << game.getLevel()
+              << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <json.hpp>
+
+//
+// Runs the game logic without a window, GPU work, or audio, as fast as it will
+// go. This is what soak tests and tick time benchmarks run on build machines.
+// Started from the command line with --headless.
+//
+struct HeadlessOptions {
+    uint64_t ticks = 10000;
+    // Generate levels until reaching this one before starting the clock
+    int level = 0;
+};
+
+int runHeadless(nlohmann::json & config, const HeadlessOptions & options);
@@ -1,9 +1,5 @@
 #pragma once
 
-#include "coordinate.hpp"
-#include "wall.hpp"
-#include <SFML/Graphics.hpp>
+#include "levelBlueprint.hpp"
 
-class tileController;
-
-void initMapVectors(tileController *);
+void initMapVectors(LevelBlueprint &);
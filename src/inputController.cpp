@@ -24,7 +24,8 @@ static sf::Keyboard::Key toSfKey(const std::string & strKey) {
     return ::translator[strKey];
 }
 
-InputController::InputController(nlohmann::json & config) {
+InputController::InputController(nlohmann::json & config)
+    : recordedState(0), latestState(0), overflowed(false) {
     try {
         auto it = config.find("Keyboard");
         const auto mapKey = [this, it](const int keyIndex,
@@ -81,33 +82,57 @@ void InputController::mapJoystickButton(const uint32_t button,
     joystickMappings[indx] = button;
 }
 
-bool InputController::pausePressed() const {
-    return keyMask[indexPause] || joystickMask[indexPause];
+void InputController::update(const time_point & tickTime) {
+    const bool dropped = overflowed.exchange(false);
+    while (const Event * event = events.front()) {
+        // Anything recorded after the tick was due waits for the next one
+        if (event->time > tickTime && !dropped) {
+            break;
+        }
+        apply(Mask(event->state));
+        events.pop();
+    }
+    if (dropped) {
+        apply(Mask(latestState.load()));
+    }
 }
 
-bool InputController::shootPressed() const {
-    return keyMask[indexShoot] || joystickMask[indexShoot];
+void InputController::consumeEdges() {
+    pressed.reset();
+    released.reset();
 }
 
-bool InputController::actionPressed() const {
-    return keyMask[indexAction] || joystickMask[indexAction];
+void InputController::apply(const Mask & state) {
+    pressed |= state & ~current;
+    released |= ~state & current;
+    current = state;
 }
 
-bool InputController::leftPressed() const {
-    return keyMask[indexLeft] || joystickMask[indexLeft];
+bool InputController::held(Button button) const {
+    return current[button] || pressed[button];
 }
 
-bool InputController::rightPressed() const {
-    return keyMask[indexRight] || joystickMask[indexRight];
+bool InputController::pressedThisTick(Button button) const {
+    return pressed[button];
 }
 
-bool InputController::upPressed() const {
-    return keyMask[indexUp] || joystickMask[indexUp];
+bool InputController::releasedThisTick(Button button) const {
+    return released[button];
 }
 
-bool InputController::downPressed() const {
-    return keyMask[indexDown] || joystickMask[indexDown];
-}
+bool InputController::pausePressed() const { return held(indexPause); }
+
+bool InputController::shootPressed() const { return held(indexShoot); }
+
+bool InputController::actionPressed() const { return held(indexAction); }
+
+bool InputController::leftPressed() const { return held(indexLeft); }
+
+bool InputController::rightPressed() const { return held(indexRight); }
+
+bool InputController::upPressed() const { return held(indexUp); }
+
+bool InputController::downPressed() const { return held(indexDown); }
 
 void InputController::recordEvent(const sf::Event & event) {
     if (event.type == sf::Event::KeyPressed) {
@@ -203,4 +228,12 @@ void InputController::recordEvent(const sf::Event & event) {
             joystickMask.reset();
         }
     }
+    const uint8_t state = (keyMask | joystickMask).to_ulong();
+    if (state != recordedState) {
+        recordedState = state;
+        latestState.store(state);
+        if (!events.push({high_resolution_clock::now(), state})) {
+            overflowed.store(true);
+        }
+    }
 }
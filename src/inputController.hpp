@@ -1,8 +1,11 @@
 #pragma once
 
+#include "alias.hpp"
+#include "framework/spscRing.hpp"
 #include "shutdownSignal.hpp"
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <json.hpp>
 #include <unordered_map>
@@ -15,9 +18,32 @@ struct JoystickInfo {
     uint8_t pause;
 };
 
+//
+// Events are recorded on the main thread, and reach the logic thread through
+// a lock-free queue of timestamped button states. At the start of each tick
+// the logic thread applies everything recorded up to that tick, so the
+// getters below describe the tick as a whole: a button that went down at any
+// point during the tick counts as pressed, even if it was released again
+// before the tick ran. The edges pile up from tick to tick until something
+// has read them and calls consumeEdges(), so a tap during a tick where
+// nothing looks at the buttons, like a hit stop, waits for the next one.
+//
 class InputController {
 public:
+    enum Button {
+        indexShoot,
+        indexAction,
+        indexPause,
+        indexLeft,
+        indexRight,
+        indexUp,
+        indexDown,
+        indexCount
+    };
     InputController(nlohmann::json &);
+    // Logic thread only
+    void update(const time_point & tickTime);
+    void consumeEdges();
     bool pausePressed() const;
     bool leftPressed() const;
     bool rightPressed() const;
@@ -25,24 +51,30 @@ public:
     bool downPressed() const;
     bool shootPressed() const;
     bool actionPressed() const;
+    bool pressedThisTick(Button) const;
+    bool releasedThisTick(Button) const;
+    // Main thread only
     void recordEvent(const sf::Event &);
     void mapKeyboardKey(const sf::Keyboard::Key, const uint8_t);
     void mapJoystickButton(const uint32_t, const uint8_t);
 
 private:
-    enum {
-        indexShoot,
-        indexAction,
-        indexPause,
-        indexLeft,
-        indexRight,
-        indexUp,
-        indexDown,
-        indexCount
+    using Mask = std::bitset<indexCount>;
+    struct Event {
+        time_point time;
+        uint8_t state;
     };
     void remapJoystick();
-    std::bitset<indexCount> keyMask;
-    std::bitset<indexCount> joystickMask;
+    void apply(const Mask &);
+    bool held(Button) const;
+    Mask keyMask, joystickMask;
+    uint8_t recordedState;
+    Mask current, pressed, released;
+    SpscRing<Event, 64> events;
+    // When the queue fills up events get dropped, the logic thread then skips
+    // straight to the latest state
+    std::atomic<uint8_t> latestState;
+    std::atomic<bool> overflowed;
     std::array<uint32_t, 3> joystickMappings;
     std::array<sf::Keyboard::Key, 7> keyboardMappings;
     std::vector<JoystickInfo> joysticks;
@@ -1,9 +1,10 @@
 #pragma once
 
+#include "alias.hpp"
 #include "inputController.hpp"
 #include "math.hpp"
-#include "util.hpp"
 #include <SFML/Graphics.hpp>
+#include <thread>
 
 inline void dispIntroSequence(sf::RenderWindow & window,
                               InputController & input) {
@@ -40,14 +41,11 @@ inline void dispIntroSequence(sf::RenderWindow & window,
                 break;
             }
         }
-        uint32_t timeDelta = introSeqClock.restart().asMicroseconds();
-        if (util::isAsleep) {
-            timeDelta = introSeqClock.restart().asMicroseconds();
-            util::isAsleep = false;
-        }
-        elapsedTime += timeDelta;
+        elapsedTime += introSeqClock.restart().asMicroseconds();
         if (!window.hasFocus()) {
-            util::sleep(milliseconds(200));
+            std::this_thread::sleep_for(milliseconds(200));
+            // Time spent waiting for focus doesn't count
+            introSeqClock.restart();
         }
         switch (state) {
         case State::dormant:
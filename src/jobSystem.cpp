@@ -0,0 +1,100 @@
+#include "jobSystem.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+JobSystem::JobSystem(nlohmann::json & config) : queued(0), stopping(false) {
+    // By default, leave a core each for the logic and render threads
+    int workerThreads = -1;
+    try {
+        auto it = config.find("Simulation");
+        if (it != config.end()) {
+            workerThreads = it->value("WorkerThreads", workerThreads);
+        }
+    } catch (const std::exception & ex) {
+        throw std::runtime_error("JSON error: " + std::string(ex.what()));
+    }
+    if (workerThreads < 0) {
+        workerThreads =
+            std::max(static_cast<int>(std::thread::hardware_concurrency()) - 2,
+                     0);
+    }
+    for (int i = 0; i <= workerThreads; ++i) {
+        queues.emplace_back(new Queue);
+    }
+    for (int i = 1; i <= workerThreads; ++i) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    workers.clear();
+}
+
+size_t JobSystem::getWorkerCount() const { return workers.size(); }
+
+void JobSystem::submit(Batch & batch, size_t count, size_t grain) {
+    size_t target = 0;
+    for (size_t begin = 0; begin < count; begin += grain) {
+        Queue & queue = *queues[target];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(
+                {&batch, begin, std::min(begin + grain, count)});
+        }
+        queued.fetch_add(1);
+        target = (target + 1) % queues.size();
+    }
+    // Taking the lock makes sure no worker is between checking for work and
+    // going to sleep, otherwise it could miss the notification
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_all();
+}
+
+bool JobSystem::runOne(size_t home) {
+    Task task;
+    bool found = false;
+    {
+        Queue & own = *queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (size_t i = 1; !found && i < queues.size(); ++i) {
+        Queue & victim = *queues[(home + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    queued.fetch_sub(1);
+    task.batch->invoke(task.batch->body, task.begin, task.end);
+    task.batch->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::workerLoop(size_t home) {
+    while (true) {
+        if (runOne(home)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queued.load() != 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
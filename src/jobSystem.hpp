@@ -0,0 +1,85 @@
+#pragma once
+
+#include "framework/smartThread.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <json.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// A small work-stealing thread pool for splitting per-entity work across
+// cores. parallelFor() cuts a range of indices into chunks and deals them out
+// to every worker's queue. Each worker takes from the back of its own queue,
+// and steals from the front of the others' when it runs dry. The calling
+// thread works through the chunks too, and returns once they're all done.
+//
+// Bodies run concurrently, so they should only read shared state and write to
+// the element they were handed. Spawning, killing, and anything else that
+// touches other entities belongs in a serial pass afterwards. Bodies must not
+// throw, and parallelFor() is only meant to be called from one thread (the
+// logic thread).
+//
+class JobSystem {
+public:
+    JobSystem(nlohmann::json &);
+    JobSystem(const JobSystem &) = delete;
+    JobSystem & operator=(const JobSystem &) = delete;
+    ~JobSystem();
+    // Calls body(i) for every i in [0, count), in chunks of grain indices.
+    // Ranges that fit in one chunk just run on the calling thread.
+    template <typename F>
+    void parallelFor(size_t count, size_t grain, const F & body) {
+        grain = std::max<size_t>(grain, 1);
+        if (workers.empty() || count <= grain) {
+            for (size_t i = 0; i < count; ++i) {
+                body(i);
+            }
+            return;
+        }
+        Batch batch;
+        batch.body = &body;
+        batch.invoke = [](const void * f, size_t begin, size_t end) {
+            const F & fn = *static_cast<const F *>(f);
+            for (size_t i = begin; i < end; ++i) {
+                fn(i);
+            }
+        };
+        batch.pending.store((count + grain - 1) / grain);
+        submit(batch, count, grain);
+        while (batch.pending.load(std::memory_order_acquire) != 0) {
+            if (!runOne(0)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    size_t getWorkerCount() const;
+
+private:
+    struct Batch {
+        const void * body;
+        void (*invoke)(const void *, size_t, size_t);
+        std::atomic<size_t> pending;
+    };
+    struct Task {
+        Batch * batch;
+        size_t begin, end;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    // Queue zero belongs to the thread calling parallelFor()
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<SmartThread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued;
+    bool stopping;
+    void submit(Batch &, size_t count, size_t grain);
+    bool runOne(size_t home);
+    void workerLoop(size_t home);
+};
@@ -0,0 +1,235 @@
+#include "jumpPoints.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+const int nodeCount = MAP_WIDTH * MAP_HEIGHT;
+const float diagonalCost = 1.41421356f;
+
+bool isWalkable(const MapLayers & layers, int x, int y) {
+    return x >= 0 && x < MAP_WIDTH && y >= 0 && y < MAP_HEIGHT &&
+           layers.test(MapLayers::Walkable, x, y);
+}
+
+// Diagonal steps only squeeze between two open tiles
+bool canStep(const MapLayers & layers, int x, int y, int xOff, int yOff) {
+    return isWalkable(layers, x + xOff, y + yOff) &&
+           (!xOff || !yOff || (isWalkable(layers, x + xOff, y) &&
+                               isWalkable(layers, x, y + yOff)));
+}
+
+// The cost of the cheapest way across an offset on open ground, which is
+// also what a straight or diagonal line of steps costs
+float estimate(int xOff, int yOff) {
+    xOff = std::abs(xOff);
+    yOff = std::abs(yOff);
+    return std::max(xOff, yOff) + (diagonalCost - 1.f) * std::min(xOff, yOff);
+}
+
+// Plain A*, every neighbour gets opened
+struct Neighbours {
+    // Calls hook(x, y, cost) for each tile a search can go to from (x, y),
+    // having got there from (fromX, fromY)
+    template <typename F>
+    static void forEachSuccessor(const MapLayers & layers, int x, int y, int,
+                                 int, int, int, const F & hook) {
+        for (int xOff = -1; xOff <= 1; ++xOff) {
+            for (int yOff = -1; yOff <= 1; ++yOff) {
+                if ((xOff || yOff) && canStep(layers, x, y, xOff, yOff)) {
+                    hook(x + xOff, y + yOff, estimate(xOff, yOff));
+                }
+            }
+        }
+    }
+};
+
+// Carries on from (x, y) in a straight or diagonal line until it gets to the
+// target or a tile where a cheapest path could turn, a jump point, and
+// leaves x and y there. Returns false if it runs into a wall first.
+bool jump(const MapLayers & layers, int & x, int & y, int xOff, int yOff,
+          int targetX, int targetY) {
+    while (canStep(layers, x, y, xOff, yOff)) {
+        x += xOff;
+        y += yOff;
+        if (x == targetX && y == targetY) {
+            return true;
+        }
+        if (xOff && yOff) {
+            // A diagonal stops wherever a straight line out of it would
+            int lineX = x, lineY = y;
+            if (jump(layers, lineX, lineY, xOff, 0, targetX, targetY)) {
+                return true;
+            }
+            lineX = x;
+            lineY = y;
+            if (jump(layers, lineX, lineY, 0, yOff, targetX, targetY)) {
+                return true;
+            }
+        } else if (xOff) {
+            // A tile beside the line that couldn't be reached from the one
+            // behind it has to be reached from here
+            if ((isWalkable(layers, x, y - 1) &&
+                 !isWalkable(layers, x - xOff, y - 1)) ||
+                (isWalkable(layers, x, y + 1) &&
+                 !isWalkable(layers, x - xOff, y + 1))) {
+                return true;
+            }
+        } else if ((isWalkable(layers, x - 1, y) &&
+                    !isWalkable(layers, x - 1, y - yOff)) ||
+                   (isWalkable(layers, x + 1, y) &&
+                    !isWalkable(layers, x + 1, y - yOff))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Rather than opening each neighbour, jumps along the lines a cheapest path
+// could take, leaving out the ones that another path would cover just as
+// cheaply
+struct JumpPoints {
+    template <typename F>
+    static void forEachSuccessor(const MapLayers & layers, int x, int y,
+                                 int fromX, int fromY, int targetX,
+                                 int targetY, const F & hook) {
+        const auto jumpTowards = [&](int xOff, int yOff) {
+            int jumpX = x, jumpY = y;
+            if (jump(layers, jumpX, jumpY, xOff, yOff, targetX, targetY)) {
+                hook(jumpX, jumpY, estimate(jumpX - x, jumpY - y));
+            }
+        };
+        const int xOff = (x > fromX) - (x < fromX);
+        const int yOff = (y > fromY) - (y < fromY);
+        if (xOff && yOff) {
+            jumpTowards(xOff, 0);
+            jumpTowards(0, yOff);
+            jumpTowards(xOff, yOff);
+        } else if (xOff || yOff) {
+            // Straight on, either way sideways, and the diagonals between
+            const int sideX = yOff ? 1 : 0, sideY = xOff ? 1 : 0;
+            jumpTowards(xOff, yOff);
+            jumpTowards(sideX, sideY);
+            jumpTowards(-sideX, -sideY);
+            jumpTowards(xOff + sideX, yOff + sideY);
+            jumpTowards(xOff - sideX, yOff - sideY);
+        } else {
+            // The origin, every way is open
+            for (int jumpX = -1; jumpX <= 1; ++jumpX) {
+                for (int jumpY = -1; jumpY <= 1; ++jumpY) {
+                    if (jumpX || jumpY) {
+                        jumpTowards(jumpX, jumpY);
+                    }
+                }
+            }
+        }
+    }
+};
+
+struct Open {
+    float f, g;
+    int node;
+    // Lower f first, and of two equal ones the node further along. The
+    // standard heap puts the greatest first, hence the flip.
+    bool operator<(const Open & other) const {
+        return f > other.f || (f == other.f && g < other.g);
+    }
+};
+
+// Kept from one search to the next, --bench paths times the searches rather
+// than the allocations
+float g[nodeCount];
+uint16_t parent[nodeCount];
+bool closed[nodeCount];
+std::vector<Open> heap;
+
+// The same search for both, the rules only decide which tiles come next.
+// Nodes can be pushed more than once, the cheapest copy comes out first and
+// the rest are skipped.
+template <typename R>
+bool search(const aStrCoordinate & origin, const aStrCoordinate & target,
+            const MapLayers & layers, std::vector<aStrCoordinate> & path,
+            int * expanded) {
+    std::fill(g, g + nodeCount, std::numeric_limits<float>::infinity());
+    std::fill(closed, closed + nodeCount, false);
+    heap.clear();
+    const int start = origin.x * MAP_HEIGHT + origin.y;
+    const int goal = target.x * MAP_HEIGHT + target.y;
+    g[start] = 0.f;
+    parent[start] = static_cast<uint16_t>(start);
+    heap.push_back({estimate(origin.x - target.x, origin.y - target.y), 0.f,
+                    start});
+    int count = 0, nearest = start, nearestDistance = 0x7fffffff;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        const Open current = heap.back();
+        heap.pop_back();
+        const int node = current.node;
+        if (closed[node]) {
+            continue;
+        }
+        closed[node] = true;
+        ++count;
+        const int x = node / MAP_HEIGHT, y = node % MAP_HEIGHT;
+        const int distance =
+            (x - target.x) * (x - target.x) + (y - target.y) * (y - target.y);
+        if (distance < nearestDistance) {
+            nearest = node;
+            nearestDistance = distance;
+        }
+        if (node == goal) {
+            break;
+        }
+        const auto relax = [&](int nextX, int nextY, float cost) {
+            const int next = nextX * MAP_HEIGHT + nextY;
+            const float nextG = current.g + cost;
+            if (!closed[next] && nextG < g[next]) {
+                g[next] = nextG;
+                parent[next] = static_cast<uint16_t>(node);
+                heap.push_back(
+                    {nextG + estimate(nextX - target.x, nextY - target.y),
+                     nextG, next});
+                std::push_heap(heap.begin(), heap.end());
+            }
+        };
+        const int from = parent[node];
+        R::forEachSuccessor(layers, x, y, from / MAP_HEIGHT, from % MAP_HEIGHT,
+                            target.x, target.y, relax);
+    }
+    if (expanded) {
+        *expanded = count;
+    }
+    path.clear();
+    for (int node = nearest;; node = parent[node]) {
+        const int x = node / MAP_HEIGHT, y = node % MAP_HEIGHT;
+        path.push_back({x, y, g[node], g[node]});
+        if (node == start) {
+            break;
+        }
+        // Jumps leave out the tiles on the line back to where they started
+        const int fromX = parent[node] / MAP_HEIGHT;
+        const int fromY = parent[node] % MAP_HEIGHT;
+        const int xOff = (fromX > x) - (fromX < x);
+        const int yOff = (fromY > y) - (fromY < y);
+        const float stepCost = estimate(xOff, yOff);
+        for (int i = 1; x + i * xOff != fromX || y + i * yOff != fromY; ++i) {
+            const float stepG = g[node] - i * stepCost;
+            path.push_back({x + i * xOff, y + i * yOff, stepG, stepG});
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return nearest == goal;
+}
+}
+
+bool astar_octile_path(const aStrCoordinate & origin,
+                       const aStrCoordinate & target, const MapLayers & layers,
+                       std::vector<aStrCoordinate> & path, int * expanded) {
+    return search<Neighbours>(origin, target, layers, path, expanded);
+}
+
+bool jps_path(const aStrCoordinate & origin, const aStrCoordinate & target,
+              const MapLayers & layers, std::vector<aStrCoordinate> & path,
+              int * expanded) {
+    return search<JumpPoints>(origin, target, layers, path, expanded);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "aStar.hpp"
+#include <vector>
+
+//
+// Jump Point Search and plain A* on the usual eight way grid: all four
+// diagonals, each costing the square root of two, and only between two open
+// tiles. JPS's pruning relies on a straight line being the only cheapest way
+// across open ground, and under the enemies' rules, with diagonals cheaper
+// than straight steps, any zigzag is just as cheap. So the game keeps
+// astar_path(), and these are only here for --bench paths and --check jps to
+// weigh the two searches against each other.
+//
+// Both write the path into path the way astar_path() does and return whether
+// target was reached. If expanded isn't null it gets how many tiles the
+// search expanded.
+//
+bool astar_octile_path(const aStrCoordinate & origin,
+                       const aStrCoordinate & target, const MapLayers & layers,
+                       std::vector<aStrCoordinate> & path,
+                       int * expanded = nullptr);
+
+// Finds paths just as cheap as astar_octile_path(), but across open ground
+// only expands the tiles where a path could turn, and jumps over the rest
+bool jps_path(const aStrCoordinate & origin, const aStrCoordinate & target,
+              const MapLayers & layers, std::vector<aStrCoordinate> & path,
+              int * expanded = nullptr);
@@ -0,0 +1,165 @@
+#include "levelBlueprint.hpp"
+#include "drawPixels.hpp"
+#include "framework/profiler.hpp"
+#include "initMapVectors.hpp"
+#include "lightingMap.hpp"
+#include "pillarPlacement.h"
+#include "resourceHandler.hpp"
+#include <cmath>
+#include <cstring>
+
+// For performance reasons, all the tiles are grouped into a single image
+static void bakeMapImages(const sf::Image & tileImage, Tile mapArray[61][61],
+                          const MapLayers & layers, sf::Image out[2],
+                          const sf::Image & grassSet,
+                          const sf::Image & grassSetEdge) {
+    uint8_t bitMask[61][61], gratePositions[61][61];
+    std::memset(bitMask, 0, sizeof(bitMask[0][0]) * std::pow(61, 2));
+    std::memset(gratePositions, 0,
+                sizeof(gratePositions[0][0]) * std::pow(61, 2));
+    for (int i = 0; i < 61; i++) {
+        for (int j = 0; j < 61; j++) {
+            if (mapArray[i][j] == Tile::Plate && !rng::random<11>()) {
+                gratePositions[i][j] = 1;
+            }
+        }
+    }
+    // Now smooth the grate positions
+    int count;
+    // Run 2 repetitions of smoothing
+    for (int rep = 2; rep > 0; rep--)
+        for (int i = 1; i < 60; i++) {
+            for (int j = 1; j < 60; j++) {
+                count = gratePositions[i - 1][j] + gratePositions[i + 1][j] +
+                        gratePositions[i][j - 1] + gratePositions[i][j + 1];
+                if (count && !rng::random<3>()) {
+                    gratePositions[i][j] = 1;
+                }
+            }
+        }
+    // Each grass tile's bit mask says which sides it joins up with other
+    // grass on. Grass edges are walls, and only join up above and below.
+    for (int i = 0; i < 61; i++) {
+        for (int j = 0; j < 61; j++) {
+            if (layers.test(MapLayers::Grass, i, j)) {
+                const uint8_t grass = layers.neighbours(MapLayers::Grass, i, j);
+                const uint8_t wall = layers.neighbours(MapLayers::Wall, i, j);
+                bitMask[i][j] =
+                    (grass & (MapLayers::North | MapLayers::South)) |
+                    (grass & ~wall & (MapLayers::East | MapLayers::West));
+            }
+        }
+    }
+    // At this point the bitmap hash values are ready for the map image
+    // generation code to interpret them
+
+    sf::Image & tileMap = out[0];
+    sf::Image & tileMapEdge = out[1];
+    // Create an image of the size 61 * tileWidth (32), by 61 * tile height (26)
+    tileMap.create(1952, 1586, sf::Color::Transparent);
+    tileMapEdge.create(1952, 1586, sf::Color::Transparent);
+    // Loop through all indices of the map array and copy the corresponding
+    // pixels from the tileset to the image
+    for (int i = 10; i < 50; i++) {
+        for (int j = 10; j < 50; j++) {
+            int select = rng::random<3>();
+            switch (mapArray[i][j]) {
+            case Tile::Plate:
+                if (gratePositions[i][j] != 1) {
+                    drawPixels(tileMap, tileImage, i, j, 0, 0);
+                } else {
+                    drawPixels(tileMap, tileImage, i, j, 256, 0);
+                }
+                break;
+
+            case Tile::Sand:
+                drawPixels(tileMap, tileImage, i, j, 32, 0);
+                break;
+
+            case Tile::SandAndGrass:
+                drawPixels(tileMap, tileImage, i, j, 64, 0);
+                break;
+
+            case Tile::PlateLowerEdge:
+                if (select == 2) {
+                    drawPixels(tileMapEdge, tileImage, i, j, 96, 0);
+                } else if (select == 1) {
+                    drawPixels(tileMapEdge, tileImage, i, j, 288, 0);
+                } else {
+                    drawPixels(tileMapEdge, tileImage, i, j, 320, 0);
+                }
+                break;
+
+            case Tile::PlateUpperEdge:
+                drawPixels(tileMap, tileImage, i, j, 128, 0);
+                break;
+
+            case Tile::Grass:
+                drawPixels(tileMap, tileImage, i, j, 0, 0);
+                if (select != 2) {
+                    drawPixels(tileMap, grassSetEdge, i, j, bitMask[i][j] * 32,
+                               0);
+                } else {
+                    drawPixels(tileMap, grassSet, i, j, bitMask[i][j] * 32, 0);
+                }
+                break;
+
+            case Tile::GrassFlowers:
+                drawPixels(tileMap, tileImage, i, j, 32, 0);
+                if (select != 2) {
+                    drawPixels(tileMap, grassSetEdge, i, j, bitMask[i][j] * 32,
+                               0);
+                } else {
+                    drawPixels(tileMap, grassSet, i, j, bitMask[i][j] * 32, 0);
+                }
+                break;
+
+            case Tile::GrassLowerEdge:
+                if (select != 2) {
+                    drawPixels(tileMapEdge, tileImage, i, j, 192, 0);
+                } else {
+                    drawPixels(tileMapEdge, tileImage, i, j, 160, 0);
+                }
+                break;
+
+            case Tile::GrassUpperEdge:
+                drawPixels(tileMap, tileImage, i, j, 224, 0);
+                break;
+
+            case Tile::Grate:
+                drawPixels(tileMap, tileImage, i, j, 256, 0);
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+}
+
+std::unique_ptr<LevelBlueprint> buildLevel(bool withImages) {
+    PROFILE_ZONE(zone, "buildLevel");
+    std::unique_ptr<LevelBlueprint> blueprint(new LevelBlueprint);
+    int count;
+    do {
+        count = generateMap(blueprint->mapArray);
+    } while (count < 150);
+    blueprint->layers.build(blueprint->mapArray);
+    if (withImages) {
+        bakeMapImages(
+            getgResHandlerPtr()->getImage(ResHandler::Image::soilTileset),
+            blueprint->mapArray, blueprint->layers, blueprint->mapImage,
+            getgResHandlerPtr()->getImage(ResHandler::Image::grassSet1),
+            getgResHandlerPtr()->getImage(ResHandler::Image::grassSet2));
+    }
+    initMapVectors(*blueprint);
+    Circle teleporterFootprint;
+    teleporterFootprint.x = blueprint->teleporterLocation.x;
+    teleporterFootprint.y = blueprint->teleporterLocation.y;
+    teleporterFootprint.r = 50;
+    getRockPositions(blueprint->mapArray, blueprint->rockPositions,
+                     teleporterFootprint);
+    getLightingPositions(blueprint->mapArray, blueprint->lampPositions,
+                         teleporterFootprint);
+    return blueprint;
+}
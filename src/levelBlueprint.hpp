@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Tile.hpp"
+#include "coordinate.hpp"
+#include "mapLayers.hpp"
+#include "mappingFunctions.hpp"
+#include "wall.hpp"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+//
+// The CPU side of a procedurally generated level: the map, the baked map
+// images, and everything placed from the map alone. None of it touches the
+// overworld or the GPU, so the next level can be built on a worker thread
+// while the teleporter transition plays, and then swapped in by
+// tileController::rebuild(), which only has to upload the textures.
+//
+struct LevelBlueprint {
+    Tile mapArray[MAP_WIDTH][MAP_HEIGHT];
+    MapLayers layers;
+    // Empty when built without images, e.g. in headless mode
+    sf::Image mapImage[2];
+    std::vector<wall> walls;
+    std::vector<Coordinate> emptyMapLocations;
+    Coordinate teleporterLocation;
+    float posX, posY;
+    std::vector<Coordinate> rockPositions, lampPositions;
+};
+
+// Fills in layers right after generating the map, everything after that reads
+// them. Uses the calling thread's rng::RNG, seed it first when running on a worker
+std::unique_ptr<LevelBlueprint> buildLevel(bool withImages);
@@ -1,14 +1,19 @@
 #include "Game.hpp"
+#include "ResourcePath.hpp"
 #include "alias.hpp"
 #include "backgroundHandler.hpp"
+#include "benchmarks.hpp"
+#include "checks.hpp"
 #include "config.h"
+#include "framework/profiler.hpp"
 #include "framework/smartThread.hpp"
+#include "headless.hpp"
 #include "inputController.hpp"
 #include "introSequence.hpp"
 #include "player.hpp"
 #include "resourceHandler.hpp"
 #include "rng.hpp"
-#include "util.hpp"
+#include "telemetry.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
@@ -22,12 +27,55 @@
 std::exception_ptr pWorkerException = nullptr;
 
 #ifdef BLINDJUMP_WINDOWS
-int main();
-int WinMain(HINSTANCE, HINSTANCE, LPSTR, int) { return main(); }
+int main(int, char **);
+int WinMain(HINSTANCE, HINSTANCE, LPSTR, int) { return main(__argc, __argv); }
 #endif
 
-int main() {
+static const char * usage = "usage: blindjump [--headless [ticks]] [--level n] "
+                            "[--check name [levels]] [--bench name [rounds]] "
+                            "[--seed n]";
+
+int main(int argc, char ** argv) {
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+    CheckOptions checkOptions;
+    BenchOptions benchOptions;
     rng::seed();
+    PROFILE_THREAD("main");
+    PROFILE_DUMP_ON_EXIT(resourcePath() + "trace.json");
+    Telemetry::installSignalHandler();
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc && argv[i + 1][0] != '-';
+            if (arg == "--headless") {
+                headless = true;
+                if (hasValue) {
+                    headlessOptions.ticks = std::stoull(argv[++i]);
+                }
+            } else if (arg == "--level" && hasValue) {
+                headlessOptions.level = std::stoi(argv[++i]);
+            } else if (arg == "--check" && hasValue) {
+                checkOptions.name = argv[++i];
+                if (i + 1 < argc && argv[i + 1][0] != '-') {
+                    checkOptions.levels = std::stoul(argv[++i]);
+                }
+            } else if (arg == "--bench" && hasValue) {
+                benchOptions.name = argv[++i];
+                if (i + 1 < argc && argv[i + 1][0] != '-') {
+                    benchOptions.rounds = std::stoul(argv[++i]);
+                }
+            } else if (arg == "--seed" && hasValue) {
+                rng::seed(std::stoul(argv[++i]));
+            } else {
+                std::cerr << usage << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    } catch (const std::exception &) {
+        std::cerr << usage << std::endl;
+        return EXIT_FAILURE;
+    }
     ResHandler resourceHandler;
     try {
         nlohmann::json configJSON;
@@ -38,31 +86,37 @@ int main() {
             std::cerr << std::string("JSON error: ") + ex.what() << std::endl;
             return EXIT_FAILURE;
         }
-        resourceHandler.load();
         setgResHandlerPtr(&resourceHandler);
+        if (!checkOptions.name.empty()) {
+            resourceHandler.loadHeadless();
+            return runCheck(checkOptions);
+        }
+        if (!benchOptions.name.empty()) {
+            resourceHandler.loadHeadless();
+            return runBenchmark(benchOptions);
+        }
+        if (headless) {
+            resourceHandler.loadHeadless();
+            return runHeadless(configJSON, headlessOptions);
+        }
+        resourceHandler.load();
         Game game(configJSON);
         configJSON.clear();
         dispIntroSequence(game.getWindow(), game.getInputController());
-        SmartThread logicThread([&game]() {
-            duration logicUpdateDelta;
-            sf::Clock gameClock;
+        // Draws from the main thread's generator so that --seed reaches the
+        // logic thread too
+        const unsigned logicSeed = rng::RNG();
+        SmartThread logicThread([&game, logicSeed]() {
+            rng::seed(logicSeed);
+            PROFILE_THREAD("logic");
+            FixedTimestep & timestep = game.getTimestep();
+            // The intro sequence may have taken a while, don't try to catch up
+            timestep.resync();
             try {
                 while (game.getWindow().isOpen()) {
-                    time_point start = high_resolution_clock::now();
-                    sf::Time elapsedTime = gameClock.restart();
-                    // TODO: what if the game freezes? Elapsed time will be
-                    // large...
-                    if (util::isAsleep) {
-                        elapsedTime = gameClock.restart();
-                        util::isAsleep = false;
-                    }
-                    game.updateLogic(elapsedTime);
-                    time_point stop = high_resolution_clock::now();
-                    logicUpdateDelta =
-                        std::chrono::duration_cast<nanoseconds>(stop - start);
-                    static const microseconds logicUpdateLimit(2000);
-                    std::this_thread::sleep_for(logicUpdateLimit -
-                                                logicUpdateDelta);
+                    timestep.advance([&game](const sf::Time & elapsedTime) {
+                        game.updateLogic(elapsedTime);
+                    });
                 }
             } catch (...) {
                 ::pWorkerException = std::current_exception();
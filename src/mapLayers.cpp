@@ -0,0 +1,63 @@
+#include "mapLayers.hpp"
+#include <atomic>
+#include <cstring>
+
+// Levels get built on worker threads
+static std::atomic<uint32_t> lastGeneration(0);
+
+MapLayers::MapLayers() : generation(0) {
+    std::memset(boards, 0, sizeof(boards));
+    std::memset(masks, 0, sizeof(masks));
+}
+
+static bool isSand(Tile t) {
+    return t == Tile::Sand || t == Tile::SandAndGrass;
+}
+
+static bool isGrass(Tile t) {
+    return t == Tile::Grass || t == Tile::GrassFlowers ||
+           t == Tile::GrassUpperEdge || t == Tile::GrassLowerEdge ||
+           t == Tile::_UNUSED1_;
+}
+
+void MapLayers::build(const Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    generation = ++lastGeneration;
+    for (int i = 0; i < MAP_WIDTH; ++i) {
+        uint64_t columns[Count] = {};
+        for (int j = 0; j < MAP_HEIGHT; ++j) {
+            const Tile t = map[i][j];
+            const uint64_t bit = uint64_t(1) << j;
+            columns[Walkable] |= isTileWalkable(t) ? bit : 0;
+            columns[Wall] |= isWallTile(t) ? bit : 0;
+            columns[Sand] |= isSand(t) ? bit : 0;
+            columns[Grass] |= isGrass(t) ? bit : 0;
+        }
+        for (int layer = 0; layer < Count; ++layer) {
+            boards[layer][i] = columns[layer];
+        }
+    }
+    // Each neighbour bit is the matching column shifted so that the
+    // neighbour's row lines up with the tile's
+    for (int layer = 0; layer < Count; ++layer) {
+        const uint64_t * board = boards[layer];
+        for (int i = 0; i < MAP_WIDTH; ++i) {
+            const uint64_t west = i > 0 ? board[i - 1] : 0;
+            const uint64_t here = board[i];
+            const uint64_t east = i < MAP_WIDTH - 1 ? board[i + 1] : 0;
+            for (int j = 0; j < MAP_HEIGHT; ++j) {
+                // Row j - 1 shifted up to j, and row j + 1 down to j
+                const auto above = [j](uint64_t column) {
+                    return j > 0 ? (column >> (j - 1)) & 1 : 0;
+                };
+                const auto below = [j](uint64_t column) {
+                    return (column >> (j + 1)) & 1;
+                };
+                masks[layer][i][j] = static_cast<uint8_t>(
+                    above(here) * North | ((east >> j) & 1) * East |
+                    below(here) * South | ((west >> j) & 1) * West |
+                    above(east) * NorthEast | below(east) * SouthEast |
+                    below(west) * SouthWest | above(west) * NorthWest);
+            }
+        }
+    }
+}
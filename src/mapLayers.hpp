@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Tile.hpp"
+#include "mappingFunctions.hpp"
+#include <cstdint>
+
+//
+// The facts about a map that everything else keeps asking, worked out once
+// when the map is generated. Each layer is a bitboard with a 64 bit column
+// per x and a bit per row, plus a mask of which of each tile's eight
+// neighbours are in the layer. Wall collision, path finding, placement and
+// tile baking all read these instead of comparing Tile values themselves.
+// Anything off the map counts as in no layer. Each build() gets a new
+// generation number, so that anything worked out from one map can tell when
+// it's stale.
+//
+class MapLayers {
+public:
+    enum Layer {
+        // What enemies and Laika can path through, see isTileWalkable()
+        Walkable,
+        // Tiles with a wall on them, see isWallTile()
+        Wall,
+        Sand,
+        // Grass and its edges, what the grass tilesets get drawn over
+        Grass,
+        Count
+    };
+    // Neighbour bits, the first four in the order the grass tilesets are
+    // laid out in
+    enum Neighbour : uint8_t {
+        North = 1,
+        East = 2,
+        South = 4,
+        West = 8,
+        NorthEast = 16,
+        SouthEast = 32,
+        SouthWest = 64,
+        NorthWest = 128
+    };
+    MapLayers();
+    void build(const Tile map[MAP_WIDTH][MAP_HEIGHT]);
+    bool test(Layer layer, int x, int y) const {
+        return (boards[layer][x] >> y) & 1;
+    }
+    // Bit y is set if tile (x, y) is in the layer
+    uint64_t column(Layer layer, int x) const { return boards[layer][x]; }
+    uint8_t neighbours(Layer layer, int x, int y) const {
+        return masks[layer][x][y];
+    }
+    // Zero until the first build()
+    uint32_t getGeneration() const { return generation; }
+    // Calls hook(x, y) for each tile of the layer in columns colBegin to
+    // colEnd and rows rowBegin to rowEnd, all inclusive and on the map, a
+    // column at a time. Stops and returns true as soon as the hook does.
+    template <typename F>
+    bool forEach(Layer layer, int colBegin, int colEnd, int rowBegin,
+                 int rowEnd, const F & hook) const {
+        const uint64_t rows =
+            (~uint64_t(0) >> (63 - rowEnd)) >> rowBegin << rowBegin;
+        for (int x = colBegin; x <= colEnd; ++x) {
+            uint64_t bits = boards[layer][x] & rows;
+            while (bits) {
+                if (hook(x, lowestBit(bits))) {
+                    return true;
+                }
+                bits &= bits - 1;
+            }
+        }
+        return false;
+    }
+
+private:
+    static int lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#else
+        int bit = 0;
+        while (!(bits & (uint64_t(1) << bit))) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+    static_assert(MAP_HEIGHT <= 64, "a map column has to fit in a board");
+    uint32_t generation;
+    uint64_t boards[Count][MAP_WIDTH];
+    uint8_t masks[Count][MAP_WIDTH][MAP_HEIGHT];
+};
@@ -8,6 +8,15 @@
 
 int generateMap(Tile map[MAP_WIDTH][MAP_HEIGHT]);
 
+// Wall and edge tiles, each one gets a wall in tileController::walls
+inline bool isWallTile(Tile t) {
+    return t == Tile::PlateLowerEdge ||
+        t == Tile::GrassLowerEdge ||
+        t == Tile::PlateUpperEdge ||
+        t == Tile::GrassUpperEdge ||
+        t == Tile::Wall;
+}
+
 inline bool isTileWalkable(Tile t) {
     return t == Tile::Sand ||
         t == Tile::SandAndGrass ||
@@ -1,5 +1,6 @@
 #include "player.hpp"
 #include "Game.hpp"
+#include "wallCollision.hpp"
 
 static const float MOVEMENT_RATE_CONSTANT = 0.000054f;
 
@@ -7,12 +8,13 @@ Player::Player(float _xPos, float _yPos)
     : gun{}, health(4), xPos(_xPos - 17), // Magic number that puts the player
                                           // in the direct center of the screen.
                                           // Hmmm why does it work...
-      yPos(_yPos), frameIndex(5), sheetIndex(Sheet::stillDown),
-      cachedSheet(Sheet::stillDown), lSpeed(0.f), rSpeed(0.f), uSpeed(0.f),
-      dSpeed(0.f), animationTimer(0), dashTimer(0), invulnerable(false),
-      state(Player::State::nominal), colorAmount(0.f), colorTimer(0),
-      renderType(Rendertype::shadeDefault), upPrevious(false),
-      downPrevious(false), leftPrevious(false), rightPrevious(false) {
+      yPos(_yPos), prevXPos(xPos), prevYPos(yPos), frameIndex(5),
+      sheetIndex(Sheet::stillDown), cachedSheet(Sheet::stillDown),
+      lSpeed(0.f), rSpeed(0.f), uSpeed(0.f), dSpeed(0.f), animationTimer(0),
+      dashTimer(0), invulnerable(false), state(Player::State::nominal),
+      colorAmount(0.f), colorTimer(0), renderType(Rendertype::shadeDefault),
+      upPrevious(false), downPrevious(false), leftPrevious(false),
+      rightPrevious(false) {
     init();
 }
 
@@ -168,7 +170,7 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
     bool collisionDown(false);
     bool collisionLeft(false);
     bool collisionRight(false);
-    uint_fast8_t collisionMask = checkCollisionWall(tiles.walls, yPos, xPos);
+    uint_fast8_t collisionMask = wallCollisionMask(tiles, xPos, yPos);
     collisionMask |= checkCollisionChest(
         details.get<DetailRef::TreasureChest>(), yPos, xPos);
     if (collisionMask & 0x01) {
@@ -297,7 +299,7 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
                     std::abs(yPos - chestPosition.y) < 26 &&
                     chest->getState() == TreasureChest::State::closed &&
                     action) {
-                    util::sleep(milliseconds(40));
+                    pGame->getTimeScale().hitStop(sf::milliseconds(40));
                     pGame->getSounds().play(ResHandler::Sound::creak, chest,
                                             64.f, 8.f);
                     chest->setState(TreasureChest::State::opening);
@@ -431,9 +433,10 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
     }
     updateColor(elapsedTime);
     if (health > 0 && state != Player::State::deactivated) {
-        checkEffectCollisions(effects, uiFrontend, sounds);
-        enemyController & enemies = pGame->getEnemyController();
-        checkEnemyCollisions(enemies, uiFrontend, sounds);
+        TimeScale & timeScale = pGame->getTimeScale();
+        CollisionIndex & collisions = pGame->getCollisionIndex();
+        checkEffectCollisions(collisions, uiFrontend, sounds, timeScale);
+        checkEnemyCollisions(collisions, uiFrontend, sounds, timeScale);
     }
     if (health <= 0 && state != Player::State::dead) {
         state = Player::State::dead;
@@ -740,19 +743,19 @@ void Player::updateGun(const sf::Time & elapsedTime, const bool shootKey,
 }
 
 template <size_t indx, typename F>
-void checkEffectCollision(EffectGroup & effects, Player * pPlayer,
+void checkEffectCollision(CollisionIndex & collisions, Player * pPlayer,
                           const F & policy) {
-    for (auto & element : effects.get<indx>()) {
-        if (pPlayer->getHitBox().overlapping(element.get()->getHitBox())) {
-            element.get()->setKillFlag();
+    collisions.forEachOverlapping<indx>(
+        pPlayer->getHitBox(), [&policy](auto & element) {
+            element.setKillFlag();
             policy();
-        }
-    }
+        });
 }
 
-void Player::checkEffectCollisions(EffectGroup & effects,
+void Player::checkEffectCollisions(CollisionIndex & collisions,
                                    ui::Frontend & uiFrontend,
-                                   SoundController & sounds) {
+                                   SoundController & sounds,
+                                   TimeScale & timeScale) {
     auto hitPolicy = [&]() {
         if (colorAmount == 0.f) {
             health -= 1;
@@ -760,28 +763,28 @@ void Player::checkEffectCollisions(EffectGroup & effects,
             renderType = Rendertype::shadeGldnGt;
             colorAmount = 1.f;
             colorTimer = 0;
-            util::sleep(milliseconds(40));
+            timeScale.hitStop(sf::milliseconds(40));
         }
     };
-    checkEffectCollision<EffectRef::EnemyShot>(effects, this, hitPolicy);
-    checkEffectCollision<EffectRef::DasherShot>(effects, this, hitPolicy);
-    checkEffectCollision<EffectRef::TurretShot>(effects, this, hitPolicy);
-    checkEffectCollision<EffectRef::Heart>(effects, this, [&]() {
+    checkEffectCollision<EffectRef::EnemyShot>(collisions, this, hitPolicy);
+    checkEffectCollision<EffectRef::DasherShot>(collisions, this, hitPolicy);
+    checkEffectCollision<EffectRef::TurretShot>(collisions, this, hitPolicy);
+    checkEffectCollision<EffectRef::Heart>(collisions, this, [&]() {
         health = fmin(uiFrontend.getMaxHealth(), health + 1);
         uiFrontend.updateHealth(health);
         renderType = Rendertype::shadeRuby;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        timeScale.hitStop(sf::milliseconds(40));
     });
-    checkEffectCollision<EffectRef::Coin>(effects, this, [&]() {
+    checkEffectCollision<EffectRef::Coin>(collisions, this, [&]() {
         uiFrontend.updateScore(1);
         renderType = Rendertype::shadeElectric;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        timeScale.hitStop(sf::milliseconds(40));
     });
-    checkEffectCollision<EffectRef::GoldHeart>(effects, this, [&] {
+    checkEffectCollision<EffectRef::GoldHeart>(collisions, this, [&] {
         char maxHealth = uiFrontend.getMaxHealth();
         uiFrontend.updateMaxHealth(maxHealth + 1);
         health = fmin(maxHealth + 1, health + 1);
@@ -789,32 +792,30 @@ void Player::checkEffectCollisions(EffectGroup & effects,
         renderType = Rendertype::shadeYellow;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        timeScale.hitStop(sf::milliseconds(40));
     });
 }
 
-template <typename F, typename T>
-void checkEnemyCollision(const std::vector<std::shared_ptr<T>> & enemyGroup,
-                         Player * pPlayer, const F & policy) {
-    for (auto & enemy : enemyGroup) {
-        if (pPlayer->getHitBox().overlapping(enemy->getHitBox())) {
-            policy();
-        }
-    }
+template <size_t kind, typename F>
+void checkEnemyCollision(CollisionIndex & collisions, Player * pPlayer,
+                         const F & policy) {
+    collisions.forEachOverlapping<kind>(pPlayer->getHitBox(),
+                                        [&policy](auto &) { policy(); });
 }
 
-void Player::checkEnemyCollisions(enemyController & enemies,
+void Player::checkEnemyCollisions(CollisionIndex & collisions,
                                   ui::Frontend & uiFrontend,
-                                  SoundController & sounds) {
+                                  SoundController & sounds,
+                                  TimeScale & timeScale) {
     auto collisionPolicy = [&]() {
         health -= 1;
         uiFrontend.updateHealth(health);
         renderType = Rendertype::shadeGldnGt;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        timeScale.hitStop(sf::milliseconds(40));
     };
-    checkEnemyCollision(enemies.getCritters(), this, [&] {
+    checkEnemyCollision<CollisionRef::Critter>(collisions, this, [&] {
         if (colorAmount == 0.f) {
             collisionPolicy();
             if (rng::random<1>()) {
@@ -824,12 +825,12 @@ void Player::checkEnemyCollisions(enemyController & enemies,
             }
         }
     });
-    checkEnemyCollision(enemies.getDashers(), this, [&] {
+    checkEnemyCollision<CollisionRef::Dasher>(collisions, this, [&] {
         if (colorAmount == 0.f) {
             collisionPolicy();
         }
     });
-    checkEnemyCollision(enemies.getScoots(), this, [&] {
+    checkEnemyCollision<CollisionRef::Scoot>(collisions, this, [&] {
         if (colorAmount == 0.f) {
             collisionPolicy();
         }
@@ -861,3 +862,12 @@ sf::Vector2f Player::requestFuturePos(const uint32_t uTime) const {
 }
 
 sf::Vector2f Player::getPosition() const { return sf::Vector2f(xPos, yPos); }
+
+void Player::savePosition() {
+    prevXPos = xPos;
+    prevYPos = yPos;
+}
+
+sf::Vector2f Player::getTickDelta() const {
+    return sf::Vector2f(prevXPos - xPos, prevYPos - yPos);
+}
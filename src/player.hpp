@@ -9,13 +9,14 @@
 #include "soundController.hpp"
 #include "spriteSheet.hpp"
 #include "tileController.hpp"
-#include "util.hpp"
+#include "timeScale.hpp"
 #include "wall.hpp"
 #include <SFML/Graphics.hpp>
 #include <cmath>
 #include <tuple>
 
 class Game;
+class CollisionIndex;
 
 class Player {
 public:
@@ -69,6 +70,8 @@ public:
     float getYVeclocty() const;
     sf::Vector2f requestFuturePos(const uint32_t) const;
     sf::Vector2f getPosition() const;
+    void savePosition();
+    sf::Vector2f getTickDelta() const;
 
 private:
     void init();
@@ -76,16 +79,17 @@ private:
     void updateGun(const sf::Time &, const bool, EffectGroup &,
                    SoundController &, ui::Backend &);
     Weapon gun;
-    void checkEffectCollisions(EffectGroup &, ui::Frontend &,
-                               SoundController &);
-    void checkEnemyCollisions(enemyController &, ui::Frontend &,
-                              SoundController &);
+    void checkEffectCollisions(CollisionIndex &, ui::Frontend &,
+                               SoundController &, TimeScale &);
+    void checkEnemyCollisions(CollisionIndex &, ui::Frontend &,
+                              SoundController &, TimeScale &);
     std::vector<Dasher::Blur> blurs; // TODO: Move blur subclass out of Dasher,
                                      // and into its own file...
     Health health;
     void updateAnimation(const sf::Time &, uint8_t, uint32_t,
                          SoundController &);
     float xPos, yPos;
+    float prevXPos, prevYPos;
     uint8_t frameIndex;
     Sheet sheetIndex, cachedSheet;
     float lSpeed, rSpeed, uSpeed, dSpeed;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "GfxContext.hpp"
+#include "alias.hpp"
+#include "math.hpp"
+#include <SFML/Graphics.hpp>
+
+//
+// Everything the render thread needs from the overworld to draw one frame,
+// copied out by the logic thread at the end of each tick. The render thread
+// never reads live entities, so it doesn't need to hold the overworld lock.
+//
+struct RenderSnapshot {
+    GfxContext gfx;
+    // Camera views at the start and at the end of the tick
+    sf::View prevOverworldView, overworldView;
+    sf::View prevWindowView, windowView;
+    sf::Vector2f cameraOffsetFromStart, cameraOffsetFromTarget;
+    bool cameraMoving = false;
+    int level = 0;
+    time_point tickTime;
+    sf::View getOverworldView(float t) const {
+        return lerpView(overworldView, prevOverworldView, t);
+    }
+    sf::View getWindowView(float t) const {
+        return lerpView(windowView, prevWindowView, t);
+    }
+
+private:
+    static sf::View lerpView(const sf::View & current, const sf::View & prev,
+                             float t) {
+        sf::View view(current);
+        view.setCenter(math::lerp(current.getCenter(), prev.getCenter(), t));
+        return view;
+    }
+};
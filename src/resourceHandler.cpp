@@ -35,6 +35,15 @@ void ResHandler::load() {
     loadSounds(resPath);
 }
 
+// Textures and shaders are skipped, nothing is drawn without a window
+void ResHandler::loadHeadless() {
+    assert(!hasResources);
+    hasResources = true;
+    const std::string resPath = resourcePath();
+    loadFonts(resPath);
+    loadImages(resPath);
+}
+
 void ResHandler::loadShaders(const std::string & resPath) {
     loadResource(resPath + "shaders/desaturate.frag", Shader::desaturate,
                  shaders);
@@ -63,6 +63,7 @@ public:
     sf::Shader & getShader(ResHandler::Shader)
         const; // Exception: shader cannot be a constant reference
     void load();
+    void loadHeadless();
 
 private:
     mutable std::array<sf::Shader, static_cast<int>(Shader::count)> shaders;
@@ -1,5 +1,5 @@
 #include "rng.hpp"
 
 namespace rng {
-std::mt19937 RNG;
+thread_local std::mt19937 RNG;
 }
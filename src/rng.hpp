@@ -4,7 +4,9 @@
 #include <random>
 
 namespace rng {
-extern std::mt19937 RNG;
+// Each thread draws from its own generator, a thread that needs
+// reproducible numbers should seed() its generator when it starts
+extern thread_local std::mt19937 RNG;
 
 template <size_t upper, int lower = 0> int random() {
     return std::abs(static_cast<int>(RNG())) % upper + lower;
@@ -18,4 +20,6 @@ inline void seed() {
     std::random_device rd;
     RNG.seed(rd() ^ static_cast<unsigned>(std::time(nullptr)));
 }
+
+inline void seed(unsigned value) { RNG.seed(value); }
 }
@@ -24,27 +24,26 @@ void Scoot::changeDir(float dir) {
     vSpeed = std::sin(dir);
 }
 
-void Scoot::update(Game * pGame, const std::vector<wall> & w,
+void Scoot::update(Game * pGame, const tileController & tiles,
                    const sf::Time & elapsedTime) {
     EffectGroup & effects = pGame->getEffects();
-    for (auto & element : effects.get<EffectRef::PlayerShot>()) {
-        if (hitBox.overlapping(element->getHitBox()) &&
-            element->checkCanPoof()) {
+    CollisionIndex & collisions = pGame->getCollisionIndex();
+    collisions.forEachOverlapping<EffectRef::PlayerShot>(
+        hitBox, [this](PlayerShot & shot) {
+            if (!shot.checkCanPoof()) {
+                return;
+            }
             if (health == 1) {
-                element->disablePuff();
-                element->setKillFlag();
+                shot.disablePuff();
+                shot.setKillFlag();
             }
-            element->poof();
+            shot.poof();
             health -= 1;
             colored = true;
             colorAmount = 1.f;
-        }
-    }
-    for (auto & helper : pGame->getHelperGroup().get<HelperRef::Laika>()) {
-        if (hitBox.overlapping(helper->getHitBox())) {
-            health = 0;
-        }
-    }
+        });
+    collisions.forEachOverlapping<CollisionRef::Laika>(
+        hitBox, [this](Laika &) { health = 0; });
     if (health == 0) {
         int select = rng::random<5>();
         if (select == 0) {
@@ -142,7 +141,7 @@ void Scoot::update(Game * pGame, const std::vector<wall> & w,
         break;
     }
     uint_fast8_t collisionMask =
-        Enemy::checkWallCollision(w, position.x - 8, position.y - 8);
+        Enemy::checkWallCollision(tiles, position.x - 8, position.y - 8);
     if (collisionMask) {
         hSpeed = 0;
         vSpeed = 0;
@@ -12,7 +12,7 @@ class Scoot : public Enemy, public std::enable_shared_from_this<Scoot> {
 public:
     using HBox = HitBox<12, 12, -6, -6>;
     Scoot(const sf::Texture &, const sf::Texture &, float, float);
-    void update(Game *, const std::vector<wall> &, const sf::Time &);
+    void update(Game *, const tileController &, const sf::Time &);
     const sf::Sprite & getSprite() const;
     const sf::Sprite & getShadow() const;
     const HBox & getHitBox() const;
@@ -3,7 +3,10 @@
 
 static const std::string musicPaths[] = {"music/Frostellar.ogg"};
 
-SoundController::SoundController() {
+SoundController::SoundController(bool _enabled) : enabled(_enabled) {
+    if (!enabled) {
+        return;
+    }
     sf::Listener::setGlobalVolume(75.f);
     currentSong.openFromFile(resourcePath() + musicPaths[0]);
     currentSong.setLoop(true);
@@ -40,6 +43,10 @@ void SoundController::unpause(int options) {
 
 void SoundController::update() {
     std::lock_guard<std::mutex> lk(soundsGuard);
+    if (!enabled) {
+        soundRequests.clear();
+        return;
+    }
     if (!soundRequests.empty()) {
         for (const auto req : soundRequests) {
             runningSounds.emplace_back(
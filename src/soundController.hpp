@@ -25,7 +25,9 @@ struct runningData {
 class SoundController {
 public:
     enum { Sound, Music };
-    SoundController();
+    // A disabled controller plays no music, and drops sound requests instead
+    // of playing them
+    explicit SoundController(bool enabled = true);
     void update();
     void pause(int);
     void unpause(int);
@@ -40,6 +42,7 @@ public:
               float minDistance, float attenuation, bool loop = false);
 
 private:
+    const bool enabled;
     std::mutex soundsGuard;
     sf::Music currentSong;
     std::deque<sf::Sound> runningSounds;
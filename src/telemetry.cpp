@@ -0,0 +1,56 @@
+#include "telemetry.hpp"
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+
+static std::atomic<bool> reportRequested(false);
+
+static uint64_t toMicroseconds(const high_resolution_clock::duration & d) {
+    return std::chrono::duration_cast<microseconds>(d).count();
+}
+
+// A sample counts as a stutter when it takes more than twice the median
+static nlohmann::json summarize(const Histogram & histogram) {
+    const uint64_t median = histogram.percentile(50);
+    nlohmann::json summary;
+    summary["Samples"] = histogram.getCount();
+    summary["P50"] = median;
+    summary["P95"] = histogram.percentile(95);
+    summary["P99"] = histogram.percentile(99);
+    summary["Max"] = histogram.getMax();
+    summary["Stutters"] = histogram.countAbove(median * 2);
+    return summary;
+}
+
+void Telemetry::recordFrame(const high_resolution_clock::duration & frameTime) {
+    frameTimes.record(toMicroseconds(frameTime));
+}
+
+void Telemetry::recordTick(const high_resolution_clock::duration & tickTime) {
+    tickTimes.record(toMicroseconds(tickTime));
+}
+
+void Telemetry::recordWakeError(
+    const high_resolution_clock::duration & error) {
+    wakeErrors.record(toMicroseconds(error));
+}
+
+bool Telemetry::write(const std::string & path,
+                      const nlohmann::json & extra) const {
+    nlohmann::json report = extra;
+    report["Frame"] = summarize(frameTimes);
+    report["Tick"] = summarize(tickTimes);
+    report["WakeError"] = summarize(wakeErrors);
+    std::ofstream out(path);
+    out << std::setw(4) << report << std::endl;
+    return static_cast<bool>(out);
+}
+
+void Telemetry::installSignalHandler() {
+#ifndef BLINDJUMP_WINDOWS
+    std::signal(SIGUSR1, [](int) { reportRequested.store(true); });
+#endif
+}
+
+bool Telemetry::takeReportRequest() { return reportRequested.exchange(false); }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "alias.hpp"
+#include "framework/histogram.hpp"
+#include <json.hpp>
+#include <string>
+
+//
+// Frame and tick time histograms. The render thread records the interval
+// between frames, the logic thread records how long each tick took to run.
+// A report with the percentiles, the worst case and a stutter count for each
+// goes to telemetry.json next to config.json when the game exits, or when the
+// process gets SIGUSR1, so that builds and settings can be compared on
+// numbers rather than feel. The frame pacer's error is reported the same way.
+// All times in the report are in microseconds.
+//
+class Telemetry {
+public:
+    void recordFrame(const high_resolution_clock::duration & frameTime);
+    void recordTick(const high_resolution_clock::duration & tickTime);
+    // How far off the frame pacer was, see framePacer.hpp
+    void recordWakeError(const high_resolution_clock::duration & error);
+    // Anything else worth knowing about the run, e.g. the level reached,
+    // goes in extra
+    bool write(const std::string & path, const nlohmann::json & extra) const;
+    // Where possible, report on SIGUSR1 (see takeReportRequest)
+    static void installSignalHandler();
+    // True once after each signal
+    static bool takeReportRequest();
+
+private:
+    Histogram frameTimes, tickTimes, wakeErrors;
+};
@@ -3,10 +3,12 @@
 #include "camera.hpp"
 #include "coordinate.hpp"
 #include "enemyController.hpp"
+#include "levelBlueprint.hpp"
 #include "resourceHandler.hpp"
 #include "wall.hpp"
 #include "mappingFunctions.hpp"
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <queue>
 #include <stack>
 
@@ -15,24 +17,35 @@ public:
     enum class Tileset { intro, regular };
     sf::Sprite transitionLvSpr;
     tileController();
-    void update();
     void draw(sf::RenderTexture &, std::vector<sf::Sprite> *, int level,
               const sf::View &, const sf::View &);
     float posX;
     float posY;
     void setPosition(float, float);
     sf::RectangleShape shadow;
-    sf::Texture mapTexture[2];
+    // Only made once there's something to draw, see setWindowSize() and
+    // rebuild(LevelBlueprint &&), so that a tileController that never draws
+    // (headless, --bench and --check) never touches GL
+    std::unique_ptr<sf::Texture> mapTexture[2];
     sf::Sprite mapSprite1, mapSprite2;
-    sf::RenderTexture rt, re;
+    std::unique_ptr<sf::RenderTexture> rt, re;
+    bool gridAligned;
     Tile mapArray[61][61];
+    // Built from mapArray along with it, see buildLevel()
+    MapLayers layers;
+    // In tile-local space, add posX and posY for world coordinates
     std::vector<wall> walls;
     std::vector<Coordinate> emptyMapLocations;
     Coordinate teleporterLocation;
     Coordinate getTeleporterLoc();
     void clear();
-    // A function to rebuild map vectors
     void rebuild(Tileset);
+    // Swaps in a level built ahead of time by buildLevel(), the map textures
+    // are only uploaded if the blueprint was built with images
+    void rebuild(LevelBlueprint &&);
+    // Whether the walls all sit on the map's tile grid, true for generated
+    // levels (see wallCollision.hpp)
+    bool isGridAligned() const;
     std::vector<Coordinate> * getEmptyLocations();
     float getPosX() const;
     float getPosY() const;
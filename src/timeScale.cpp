@@ -0,0 +1,22 @@
+#include "timeScale.hpp"
+#include <algorithm>
+
+TimeScale::TimeScale() : remaining(sf::Time::Zero), scale(1.f) {}
+
+void TimeScale::hitStop(const sf::Time & length, float _scale) {
+    if (remaining == sf::Time::Zero || _scale < scale) {
+        remaining = length;
+        scale = _scale;
+    } else if (_scale == scale) {
+        remaining = std::max(remaining, length);
+    }
+}
+
+sf::Time TimeScale::update(const sf::Time & elapsedTime) {
+    if (remaining == sf::Time::Zero) {
+        return elapsedTime;
+    }
+    const sf::Time scaled = std::min(elapsedTime, remaining);
+    remaining -= scaled;
+    return elapsedTime - scaled + scaled * scale;
+}
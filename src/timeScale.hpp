@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+//
+// Hit stop that doesn't block the logic thread. Gameplay code asks for the
+// world to freeze (or slow down) for a while, and Game scales the time it
+// passes to the world's entities accordingly. The camera, UI, transitions and
+// sound keep running on real time.
+//
+class TimeScale {
+public:
+    TimeScale();
+    // Run the world at scale (zero freezes it) for length of real time.
+    // Requests don't stack: a stronger one replaces the current one, one as
+    // strong extends it, and a weaker one is ignored.
+    void hitStop(const sf::Time & length, float scale = 0.f);
+    // Advance by one tick of real time, returns the world's share of it
+    sf::Time update(const sf::Time & elapsedTime);
+
+private:
+    sf::Time remaining;
+    float scale;
+};
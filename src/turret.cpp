@@ -30,24 +30,23 @@ void Turret::update(const sf::Time & elapsedTime, Game * pGame) {
             isColored = false;
         }
     }
-    for (auto & element : effects.get<EffectRef::PlayerShot>()) {
-        if (hitBox.overlapping(element->getHitBox()) &&
-            element->checkCanPoof()) {
+    CollisionIndex & collisions = pGame->getCollisionIndex();
+    collisions.forEachOverlapping<EffectRef::PlayerShot>(
+        hitBox, [this](PlayerShot & shot) {
+            if (!shot.checkCanPoof()) {
+                return;
+            }
             if (hp == 1) {
-                element->disablePuff();
-                element->setKillFlag();
+                shot.disablePuff();
+                shot.setKillFlag();
             }
-            element->poof();
+            shot.poof();
             hp -= 1;
             isColored = true;
             colorAmount = 1.f;
-        }
-    }
-    for (auto & helper : pGame->getHelperGroup().get<HelperRef::Laika>()) {
-        if (hitBox.overlapping(helper->getHitBox())) {
-            hp = 0;
-        }
-    }
+        });
+    collisions.forEachOverlapping<CollisionRef::Laika>(
+        hitBox, [this](Laika &) { hp = 0; });
     if (hp == 0) {
         killFlag = true;
         if (rng::random<4>() == 0) {
@@ -300,8 +300,7 @@ void ui::Backend::update(Game * pGame, const sf::Time & elapsedTime) {
             const sf::Vector2f playerPos = pGame->getPlayer().getPosition();
             hg.add<HelperRef::Laika>(playerPos.x, playerPos.y + 32,
                                      getgResHandlerPtr()->getTexture(
-                                         ResHandler::Texture::gameObjects),
-                                     pGame->getTileController().mapArray);
+                                         ResHandler::Texture::gameObjects));
         } break;
         }
         powerupBubbleState = PowerupBubbleState::dormant;
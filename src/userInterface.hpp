@@ -73,7 +73,6 @@ public:
 
 private:
     float scale;
-    sf::Texture texture;
     sf::View fontView;
     sf::Text waypointText, titleText, deathText, scoreText, healthNumText;
     sf::Text resumeText, quitText, powerupText;
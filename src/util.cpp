@@ -1,3 +0,0 @@
-#include "util.hpp"
-
-bool util::isAsleep(false);
@@ -0,0 +1,12 @@
+#include "viewCuller.hpp"
+
+ViewCuller::ViewCuller() : left(0.f), top(0.f), right(0.f), bottom(0.f) {}
+
+void ViewCuller::setView(const sf::View & view) {
+    const sf::Vector2f & center = view.getCenter();
+    const sf::Vector2f & size = view.getSize();
+    left = center.x - size.x / 2;
+    right = center.x + size.x / 2;
+    top = center.y - size.y / 2;
+    bottom = center.y + size.y / 2;
+}
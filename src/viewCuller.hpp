@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+//
+// Answers what's on screen. Game hands it the camera view once per tick and
+// again before drawing, and drawing, Laika's target search and the enemies'
+// wake up all go through it rather than each keeping their own copy of the
+// test. The margin says how far past the edge of the view still counts, the
+// enemies use 32 pixels and everything else 128. Testing each position
+// straight against the view is a handful of comparisons, a good deal cheaper
+// than filing everything in a spatial hash every tick would be, see --bench
+// cull.
+//
+class ViewCuller {
+public:
+    ViewCuller();
+    void setView(const sf::View &);
+    // Whether position is within margin pixels of the view, edges excluded
+    bool contains(const sf::Vector2f & position, float margin) const {
+        return position.x > left - margin && position.x < right + margin &&
+               position.y > top - margin && position.y < bottom + margin;
+    }
+    // Calls hook(element) for every element of elements whose position is
+    // within margin of the view, in the same order as elements. The hook
+    // must not add to or remove from elements.
+    template <typename T, typename F>
+    void forEachVisible(const std::vector<std::shared_ptr<T>> & elements,
+                        float margin, const F & hook) const {
+        for (const auto & element : elements) {
+            if (contains(element->getPosition(), margin)) {
+                hook(element);
+            }
+        }
+    }
+
+private:
+    float left, top, right, bottom;
+};
@@ -0,0 +1,283 @@
+#include "wallCollision.hpp"
+#include "mappingFunctions.hpp"
+#include "tileController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+static uint_fast8_t probeWall(const wall & w, float xPos, float yPos) {
+    uint_fast8_t collisionMask = 0;
+    if ((xPos + 6 < (w.getPosX() + w.getWidth()) &&
+         (xPos + 6 > (w.getPosX()))) &&
+        (fabs((yPos + 16) - w.getPosY()) <= 13)) {
+        collisionMask |= 0x01;
+    }
+    if ((xPos + 24 > (w.getPosX()) &&
+         (xPos + 24 < (w.getPosX() + w.getWidth()))) &&
+        (fabs((yPos + 16) - w.getPosY()) <= 13)) {
+        collisionMask |= 0x02;
+    }
+    if (((yPos + 22 < (w.getPosY() + w.getHeight())) &&
+         (yPos + 22 > (w.getPosY()))) &&
+        (fabs((xPos)-w.getPosX()) <= 16)) {
+        collisionMask |= 0x04;
+    }
+    if (((yPos + 36 > w.getPosY()) &&
+         (yPos + 36 < w.getPosY() + w.getHeight())) &&
+        (fabs((xPos)-w.getPosX()) <= 16)) {
+        collisionMask |= 0x08;
+    }
+    return collisionMask;
+}
+
+uint_fast8_t scanWallCollision(const tileController & tiles, float xPos,
+                               float yPos) {
+    const float x = xPos - tiles.posX, y = yPos - tiles.posY;
+    uint_fast8_t collisionMask = 0;
+    for (auto & w : tiles.walls) {
+        collisionMask |= probeWall(w, x, y);
+    }
+    return collisionMask;
+}
+
+// The tile index a coordinate falls in, clamped to just outside the map so
+// that far away probes don't overflow
+static int tileIndex(float offset, float tileSize, int tileCount) {
+    const float index = std::floor(offset / tileSize);
+    return static_cast<int>(
+        std::min(std::max(index, -1.f), static_cast<float>(tileCount)));
+}
+
+// The wall on map tile (i, j), in tile-local space like all the others
+static wall gridWall(int i, int j) {
+    wall w;
+    w.setXinit(i * 32);
+    w.setYinit(j * 26);
+    w.setPosition(w.getXinit(), w.getYinit());
+    return w;
+}
+
+uint_fast8_t wallCollisionMask(const tileController & tiles, float xPos,
+                               float yPos) {
+    if (!tiles.isGridAligned()) {
+        return scanWallCollision(tiles, xPos, yPos);
+    }
+    const float x = xPos - tiles.posX, y = yPos - tiles.posY;
+    // A wall can only touch the probe if its top left corner is within
+    // (-26, 24) horizontally and (-4, 36) vertically, widen that by a tile
+    // on each side to absorb any rounding in the division
+    const int colBegin = std::max(tileIndex(x - 26, 32, MAP_WIDTH) - 1, 0);
+    const int colEnd =
+        std::min(tileIndex(x + 24, 32, MAP_WIDTH) + 1, MAP_WIDTH - 1);
+    const int rowBegin = std::max(tileIndex(y - 4, 26, MAP_HEIGHT) - 1, 0);
+    const int rowEnd =
+        std::min(tileIndex(y + 36, 26, MAP_HEIGHT) + 1, MAP_HEIGHT - 1);
+    uint_fast8_t collisionMask = 0;
+    tiles.layers.forEach(MapLayers::Wall, colBegin, colEnd, rowBegin, rowEnd,
+                         [&collisionMask, x, y](int i, int j) {
+                             collisionMask |= probeWall(gridWall(i, j), x, y);
+                             return false;
+                         });
+    return collisionMask;
+}
+
+// Worked out from probeWall(): the left and right probes reach from 24 pixels
+// left of the wall to 26 right of it, within 29 above to 3 above; the top and
+// bottom probes reach 16 either side, from 36 above to 4 below. The edges are
+// treated as inside, which can only err towards seeing a wall.
+static void footprintsOf(const wall & w, WallFootprint out[2]) {
+    const float x = w.getPosX(), y = w.getPosY();
+    out[0] = {x - 24, y - 29, x + 26, y - 3};
+    out[1] = {x - 16, y - 36, x + 16, y + 4};
+}
+
+// Slab test of the segment from (x0, y0) along (dx, dy) against a rectangle,
+// tEnter is how far along the segment it gets in, zero if it starts inside
+static bool segmentEntersRect(float x0, float y0, float dx, float dy,
+                              const WallFootprint & rect, float & tEnter) {
+    float tMin = 0.f, tMax = 1.f;
+    const float origin[2] = {x0, y0}, delta[2] = {dx, dy};
+    const float low[2] = {rect.left, rect.top};
+    const float high[2] = {rect.right, rect.bottom};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.f) {
+            if (origin[axis] < low[axis] || origin[axis] > high[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (low[axis] - origin[axis]) / delta[axis];
+        float t1 = (high[axis] - origin[axis]) / delta[axis];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    tEnter = tMin;
+    return true;
+}
+
+static bool segmentHitsRect(float x0, float y0, float dx, float dy,
+                            const WallFootprint & rect) {
+    float tEnter;
+    return segmentEntersRect(x0, y0, dx, dy, rect, tEnter);
+}
+
+static bool segmentHitsWall(const wall & w, float x0, float y0, float dx,
+                            float dy) {
+    WallFootprint footprints[2];
+    footprintsOf(w, footprints);
+    return segmentHitsRect(x0, y0, dx, dy, footprints[0]) ||
+           segmentHitsRect(x0, y0, dx, dy, footprints[1]);
+}
+
+// Same as scanWallAlongSegment() with the segment already in tile-local
+// space
+static bool scanLocalSegment(const std::vector<wall> & walls, float x0,
+                             float y0, float dx, float dy) {
+    for (auto & w : walls) {
+        if (segmentHitsWall(w, x0, y0, dx, dy)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool scanWallAlongSegment(const tileController & tiles, float x0, float y0,
+                          float x1, float y1) {
+    return scanLocalSegment(tiles.walls, x0 - tiles.posX, y0 - tiles.posY,
+                            x1 - x0, y1 - y0);
+}
+
+bool wallAlongSegment(const tileController & tiles, float x0, float y0,
+                      float x1, float y1) {
+    const float dx = x1 - x0, dy = y1 - y0;
+    x0 -= tiles.posX;
+    y0 -= tiles.posY;
+    x1 = x0 + dx;
+    y1 = y0 + dy;
+    if (!tiles.isGridAligned()) {
+        return scanLocalSegment(tiles.walls, x0, y0, dx, dy);
+    }
+    int col = tileIndex(x0, 32, MAP_WIDTH);
+    int row = tileIndex(y0, 26, MAP_HEIGHT);
+    const int endCol = tileIndex(x1, 32, MAP_WIDTH);
+    const int endRow = tileIndex(y1, 26, MAP_HEIGHT);
+    // tileIndex() clamps, which would throw the walk off course
+    if (std::min({col, endCol}) < 0 || std::max({col, endCol}) >= MAP_WIDTH ||
+        std::min({row, endRow}) < 0 || std::max({row, endRow}) >= MAP_HEIGHT) {
+        return scanLocalSegment(tiles.walls, x0, y0, dx, dy);
+    }
+    const int stepCol = dx > 0 ? 1 : -1, stepRow = dy > 0 ? 1 : -1;
+    // How far along the segment the next column and row boundaries are, and
+    // how far apart they are after that
+    const float inf = std::numeric_limits<float>::infinity();
+    float tNextCol = dx != 0.f ? ((col + (dx > 0)) * 32 - x0) / dx : inf;
+    float tNextRow = dy != 0.f ? ((row + (dy > 0)) * 26 - y0) / dy : inf;
+    const float tColStep = dx != 0.f ? 32 / std::fabs(dx) : inf;
+    const float tRowStep = dy != 0.f ? 26 / std::fabs(dy) : inf;
+    int cells = std::abs(endCol - col) + std::abs(endRow - row) + 1;
+    while (cells-- > 0) {
+        // A probe in this cell can only reach walls in the next column and
+        // the next two rows, the extra tile around that absorbs rounding
+        const bool hit = tiles.layers.forEach(
+            MapLayers::Wall, std::max(col - 1, 0),
+            std::min(col + 1, MAP_WIDTH - 1), std::max(row - 1, 0),
+            std::min(row + 2, MAP_HEIGHT - 1), [=](int i, int j) {
+                return segmentHitsWall(gridWall(i, j), x0, y0, dx, dy);
+            });
+        if (hit) {
+            return true;
+        }
+        if (tNextCol < tNextRow) {
+            col += stepCol;
+            tNextCol += tColStep;
+        } else {
+            row += stepRow;
+            tNextRow += tRowStep;
+        }
+    }
+    return false;
+}
+
+// Calls hook(wall) for each wall with its top left corner within the given
+// tile-local bounds, give or take a tile
+template <typename F>
+static void forEachWallNear(const tileController & tiles, float left,
+                            float top, float right, float bottom,
+                            const F & hook) {
+    if (!tiles.isGridAligned()) {
+        for (auto & w : tiles.walls) {
+            if (w.getPosX() >= left && w.getPosX() <= right &&
+                w.getPosY() >= top && w.getPosY() <= bottom) {
+                hook(w);
+            }
+        }
+        return;
+    }
+    const int colBegin = std::max(tileIndex(left, 32, MAP_WIDTH) - 1, 0);
+    const int colEnd =
+        std::min(tileIndex(right, 32, MAP_WIDTH) + 1, MAP_WIDTH - 1);
+    const int rowBegin = std::max(tileIndex(top, 26, MAP_HEIGHT) - 1, 0);
+    const int rowEnd =
+        std::min(tileIndex(bottom, 26, MAP_HEIGHT) + 1, MAP_HEIGHT - 1);
+    tiles.layers.forEach(MapLayers::Wall, colBegin, colEnd, rowBegin, rowEnd,
+                         [&hook](int i, int j) {
+                             hook(gridWall(i, j));
+                             return false;
+                         });
+}
+
+void gatherWallFootprints(const tileController & tiles, float xPos,
+                          float yPos, float radius,
+                          std::vector<WallFootprint> & out) {
+    out.clear();
+    const float x = xPos - tiles.posX, y = yPos - tiles.posY;
+    // Same reach as the footprints themselves, see footprintsOf()
+    WallFootprint footprints[2];
+    forEachWallNear(tiles, x - radius - 26, y - radius - 4, x + radius + 24,
+                    y + radius + 36, [&out, &footprints](const wall & w) {
+                        footprintsOf(w, footprints);
+                        out.insert(out.end(), footprints, footprints + 2);
+                    });
+}
+
+float wallSweep(const tileController & tiles, float x0, float y0, float x1,
+                float y1) {
+    const float dx = x1 - x0, dy = y1 - y0;
+    x0 -= tiles.posX;
+    y0 -= tiles.posY;
+    float first = 1.f;
+    WallFootprint footprints[2];
+    forEachWallNear(
+        tiles, std::min(x0, x0 + dx) - 26, std::min(y0, y0 + dy) - 4,
+        std::max(x0, x0 + dx) + 24, std::max(y0, y0 + dy) + 36,
+        [&](const wall & w) {
+            footprintsOf(w, footprints);
+            for (auto & footprint : footprints) {
+                float t;
+                // A wall the probe starts out touching is one it's moving
+                // away from, or already up against
+                if (segmentEntersRect(x0, y0, dx, dy, footprint, t) &&
+                    t > 0.f) {
+                    first = std::min(first, t);
+                }
+            }
+        });
+    return first;
+}
+
+bool footprintsAlongSegment(const std::vector<WallFootprint> & footprints,
+                            float x0, float y0, float x1, float y1) {
+    for (auto & footprint : footprints) {
+        if (segmentHitsRect(x0, y0, x1 - x0, y1 - y0, footprint)) {
+            return true;
+        }
+    }
+    return false;
+}
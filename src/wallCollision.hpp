@@ -0,0 +1,61 @@
+#pragma once
+
+#include "wall.hpp"
+#include <cstdint>
+#include <vector>
+
+class tileController;
+
+//
+// Which sides of a probe at (xPos, yPos) are up against a wall, as a mask of
+// 0x01 left, 0x02 right, 0x04 up and 0x08 down. The probe is the same one
+// the player and the enemies have always used, see probeWall().
+//
+// Walls are kept in tile-local space, so they don't move when the level does;
+// the queries here take world coordinates and subtract the tileController's
+// position once. Walls in a generated level sit on the tile grid, so only the
+// few map tiles around the probe need looking at. The intro level's walls are
+// placed by hand, that one still gets checked wall by wall.
+//
+uint_fast8_t wallCollisionMask(const tileController &, float xPos, float yPos);
+
+// Checks every wall, this is what wallCollisionMask() has to agree with
+uint_fast8_t scanWallCollision(const tileController &, float xPos,
+                               float yPos);
+
+// The region a probe's position has to be in for it to touch one wall, as
+// two overlapping rectangles: one for the left and right sides of the probe
+// and one for the top and bottom
+struct WallFootprint {
+    float left, top, right, bottom;
+};
+
+// Whether a probe moved in a straight line from (x0, y0) to (x1, y1) would
+// touch a wall anywhere along the way, not just at a few sample points.
+// Walks the tile grid cell by cell from the start (a DDA), so it stops at the
+// first wall and only looks at tiles the line passes near.
+bool wallAlongSegment(const tileController &, float x0, float y0, float x1,
+                      float y1);
+
+// Checks against every wall, this is what wallAlongSegment() has to agree
+// with
+bool scanWallAlongSegment(const tileController &, float x0, float y0,
+                          float x1, float y1);
+
+// Collects the footprints of every wall a probe could touch within radius of
+// (xPos, yPos), for testing lots of segments from about the same place. The
+// footprints are in tile-local space, so are the segments tested against
+// them.
+void gatherWallFootprints(const tileController &, float xPos, float yPos,
+                          float radius, std::vector<WallFootprint> & out);
+
+bool footprintsAlongSegment(const std::vector<WallFootprint> &, float x0,
+                            float y0, float x1, float y1);
+
+// How far a probe moving in a straight line from (x0, y0) to (x1, y1) gets
+// before it touches a wall, as a fraction of the way, or 1 if it never does.
+// Walls the probe is touching at the start don't stop it. For things that
+// move further in a tick than the probe is wide, which would otherwise pass
+// straight through a wall between two ticks.
+float wallSweep(const tileController &, float x0, float y0, float x1,
+                float y1);